@@ -36,6 +36,9 @@ CONFIG += CG3_CORE CG3_VIEWER
 include (cg3lib/cg3.pri)
 message($$MODULES)
 
+# Voronoi engine (sweep, beachline, DCEL and mathVoronoi kernels)
+include (voronoi_engine.pri)
+
 
 DISTFILES += \
     LICENSE
@@ -44,15 +47,7 @@ SOURCES += \
     main.cpp \
     utils/fileutils.cpp \
     managers/voronoimanager.cpp \
-    data_structures/vertex.tpp \
-    data_structures/half_edge.tpp \
-    data_structures/dcel.cpp \
-    data_structures/beachline.cpp \
-    mathVoronoi/parabola.cpp \
-    mathVoronoi/circle.cpp \
-    algorithms/voronoidiagram.cpp \
-    viewer/drawablevoronoidiagram.cpp \
-    data_structures/event.cpp
+    viewer/drawablevoronoidiagram.cpp
 
 FORMS += \
     managers/voronoimanager.ui
@@ -60,15 +55,7 @@ FORMS += \
 HEADERS += \
     utils/fileutils.h \
     managers/voronoimanager.h \
-    data_structures/vertex.h \
-    data_structures/half_edge.h \
-    data_structures/dcel.h \
-    data_structures/beachline.h \
-    mathVoronoi/parabola.h \
-    mathVoronoi/circle.h \
-    algorithms/voronoidiagram.h \
-    viewer/drawablevoronoidiagram.h \
-    data_structures/event.h
+    viewer/drawablevoronoidiagram.h
 
 
 
@@ -0,0 +1,46 @@
+# Standalone build of the Voronoi engine, without Qt, OpenGL and the cg3 viewer.
+# By default a static library is built, add "CONFIG += VORONOI_ENGINE_SHARED"
+# to build a shared one.
+
+TEMPLATE = lib
+TARGET = voronoiengine
+
+CONFIG -= qt
+CONFIG += c++11
+
+VORONOI_ENGINE_SHARED {
+    CONFIG += shared
+}
+else {
+    CONFIG += staticlib
+}
+
+# Debug configuration
+CONFIG(debug, debug|release){
+    DEFINES += DEBUG
+}
+
+# Release configuration
+CONFIG(release, debug|release){
+    DEFINES -= DEBUG
+    unix:!macx{
+        QMAKE_CXXFLAGS_RELEASE -= -g -O2
+        QMAKE_CXXFLAGS += -O3 -DNDEBUG
+    }
+}
+
+win32 {
+    DEFINES += _USE_MATH_DEFINES
+}
+
+# OpenMP is used by the parallel parts of the engine (e.g. the sort of the sites),
+# without it they run on a single thread
+unix:!macx{
+    QMAKE_CXXFLAGS += -fopenmp
+    QMAKE_LFLAGS += -fopenmp
+}
+
+# Only the header-only geometry primitives of cg3 core are needed
+INCLUDEPATH += $$PWD/cg3lib/cg3/core/
+
+include (voronoi_engine.pri)
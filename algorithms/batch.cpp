@@ -0,0 +1,168 @@
+#include "batch.h"
+
+#include <algorithm>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace Voronoi {
+
+    namespace internal {
+
+        /**
+         * @brief The StagedDiagram struct, where a diagram of the batch is in the buffers of its worker,
+         * and the origin of the coordinates of its vertexs
+         */
+        struct StagedDiagram {
+            size_t worker, vertexBegin, halfEdgeBegin, faceBegin;
+            cg3::Point2Dd origin;
+        };
+
+        /**
+         * @brief shiftIndex moves index by offset, the "empty" reference is kept
+         */
+        inline size_t shiftIndex(size_t index, size_t offset) {
+            return index == std::numeric_limits<size_t>::max() ? index : index + offset;
+        }
+
+        /**
+         * @brief stageDiagram appends the elements of the diagram in the DCEL of worker to its buffers
+         */
+        void stageDiagram(BatchWorker& worker) {
+            const DCEL& dcel = worker.dcel;
+            worker.vertexs.insert(worker.vertexs.end(), dcel.getVertexs().begin(), dcel.getVertexs().end());
+            worker.halfEdges.insert(worker.halfEdges.end(), dcel.getHalfEdges().begin(), dcel.getHalfEdges().end());
+            worker.faces.insert(worker.faces.end(), dcel.getFaces().begin(), dcel.getFaces().end());
+        }
+
+        /**
+         * @brief moveDiagram copies the elements of the staged diagram d in their ranges of the DCEL of the batch,
+         * moving their indices by the beginning of the ranges and their coordinates to the origin of the batch
+         */
+        void moveDiagram(DiagramBatch& batch, const StagedDiagram& staged, size_t d) {
+            const BatchWorker& worker = *batch.workers[staged.worker];
+            const size_t vertexOffset = batch.vertexOffsets[d], halfEdgeOffset = batch.halfEdgeOffsets[d],
+                    faceOffset = batch.faceOffsets[d];
+            std::vector<Vertex>& vertexs = batch.dcel.getVertexs();
+            std::vector<HalfEdge>& halfEdges = batch.dcel.getHalfEdges();
+            std::vector<Face>& faces = batch.dcel.getFaces();
+
+            for(size_t i = 0; i < batch.vertexOffsets[d+1] - vertexOffset; i++) {
+                const Vertex& v = worker.vertexs[staged.vertexBegin + i];
+                vertexs[vertexOffset + i] = batch.dcel.makeVertex(staged.origin + v.getCoordinates(),
+                                                                  shiftIndex(v.getIncidEdgeID(), halfEdgeOffset));
+            }
+            for(size_t i = 0; i < batch.halfEdgeOffsets[d+1] - halfEdgeOffset; i++) {
+                HalfEdge e = worker.halfEdges[staged.halfEdgeBegin + i];
+                e.setOrigin(shiftIndex(e.getOriginID(), vertexOffset));
+#ifndef VORONOI_COMPACT_DCEL
+                e.setTwin(shiftIndex(e.getTwinID(), halfEdgeOffset));
+#endif
+                e.setNext(shiftIndex(e.getNextID(), halfEdgeOffset));
+                e.setPrev(shiftIndex(e.getPrevID(), halfEdgeOffset));
+                e.setFace(shiftIndex(e.getFaceID(), faceOffset));
+                halfEdges[halfEdgeOffset + i] = e;
+            }
+            for(size_t i = 0; i < batch.faceOffsets[d+1] - faceOffset; i++) {
+                Face f = worker.faces[staged.faceBegin + i];
+                f.setIncidEdge(shiftIndex(f.getIncidEdgeID(), halfEdgeOffset));
+                faces[faceOffset + i] = f;
+            }
+        }
+
+    }
+
+    /**
+     * @brief computeVoronoiDiagrams computes the diagrams of many independent sets of sites (e.g. the tiles of a map)
+     * with nThreads threads, each one with its own workspace for the sweep.
+     * The diagrams are assigned to the threads one at a time, the largest ones first, so the threads that get small
+     * diagrams take the next ones instead of waiting. Each thread keeps its diagrams in its buffers; then the DCEL
+     * of the batch is sized once for all the diagrams, and each one is copied in its own range
+     * @param pointSets: the sites of each diagram
+     * @param boundingBoxes: the box of each diagram, the cells are closed by its boundary
+     * @param batch: output, the diagrams in the same order of pointSets, each one as computed by computeVoronoiDiagram
+     * @param nThreads: the number of threads, 0 for the default number of OpenMP
+     */
+    void computeVoronoiDiagrams(const std::vector<std::vector<cg3::Point2Dd>>& pointSets,
+                                const std::vector<cg3::BoundingBox2D>& boundingBoxes, DiagramBatch& batch, int nThreads) {
+        const size_t nDiagrams = pointSets.size();
+        const long long nDiagramsSigned = static_cast<long long>(nDiagrams);
+
+        #ifdef _OPENMP
+        if(nThreads <= 0)
+            nThreads = omp_get_max_threads();
+        #else
+        nThreads = 1;
+        #endif
+        nThreads = static_cast<int>(std::max<size_t>(1, std::min(static_cast<size_t>(nThreads), nDiagrams)));
+
+        if(batch.workers.size() < static_cast<size_t>(nThreads))
+            batch.workers.resize(static_cast<size_t>(nThreads));
+        for(int w = 0; w < nThreads; w++) {
+            if(!batch.workers[w])
+                batch.workers[w].reset(new BatchWorker());
+            batch.workers[w]->vertexs.clear();
+            batch.workers[w]->halfEdges.clear();
+            batch.workers[w]->faces.clear();
+        }
+
+        std::vector<size_t> order(nDiagrams);
+        for(size_t d = 0; d < nDiagrams; d++)
+            order[d] = d;
+        std::stable_sort(order.begin(), order.end(), [&pointSets](size_t a, size_t b) {
+            return pointSets[a].size() > pointSets[b].size();
+        });
+
+        //Each diagram is computed in the DCEL of the worker and appended to its buffers
+        std::vector<internal::StagedDiagram> staged(nDiagrams);
+        batch.faceOffsets.assign(nDiagrams + 1, 0);
+        batch.halfEdgeOffsets.assign(nDiagrams + 1, 0);
+        batch.vertexOffsets.assign(nDiagrams + 1, 0);
+        #pragma omp parallel for schedule(dynamic, 1) num_threads(nThreads)
+        for(long long i = 0; i < nDiagramsSigned; i++) {
+            const size_t d = order[static_cast<size_t>(i)];
+            size_t w = 0;
+            #ifdef _OPENMP
+            w = static_cast<size_t>(omp_get_thread_num());
+            #endif
+            BatchWorker& worker = *batch.workers[w];
+            worker.dcel.clear();
+            computeVoronoiDiagram(pointSets[d], worker.dcel, boundingBoxes[d], worker.workspace);
+
+            staged[d].worker = w;
+            staged[d].vertexBegin = worker.vertexs.size();
+            staged[d].halfEdgeBegin = worker.halfEdges.size();
+            staged[d].faceBegin = worker.faces.size();
+            staged[d].origin = worker.dcel.getOrigin();
+            batch.vertexOffsets[d+1] = worker.dcel.getVertexs().size();
+            batch.halfEdgeOffsets[d+1] = worker.dcel.getHalfEdges().size();
+            batch.faceOffsets[d+1] = worker.dcel.getFaces().size();
+            internal::stageDiagram(worker);
+        }
+
+        for(size_t d = 0; d < nDiagrams; d++) {
+            batch.vertexOffsets[d+1] += batch.vertexOffsets[d];
+            batch.halfEdgeOffsets[d+1] += batch.halfEdgeOffsets[d];
+            batch.faceOffsets[d+1] += batch.faceOffsets[d];
+        }
+
+        //The ranges of the diagrams are disjoint, so they are filled in parallel
+        batch.dcel.clear();
+        if(nDiagrams > 0) {
+            cg3::Point2Dd min = boundingBoxes[0].min(), max = boundingBoxes[0].max();
+            for(const cg3::BoundingBox2D& box : boundingBoxes) {
+                min = cg3::Point2Dd(std::min(min.x(), box.min().x()), std::min(min.y(), box.min().y()));
+                max = cg3::Point2Dd(std::max(max.x(), box.max().x()), std::max(max.y(), box.max().y()));
+            }
+            batch.dcel.fitOrigin(cg3::BoundingBox2D(min, max));
+        }
+        batch.dcel.getVertexs().resize(batch.vertexOffsets[nDiagrams]);
+        batch.dcel.getHalfEdges().resize(batch.halfEdgeOffsets[nDiagrams]);
+        batch.dcel.getFaces().resize(batch.faceOffsets[nDiagrams]);
+        #pragma omp parallel for schedule(dynamic, 1) num_threads(nThreads)
+        for(long long d = 0; d < nDiagramsSigned; d++)
+            internal::moveDiagram(batch, staged[static_cast<size_t>(d)], static_cast<size_t>(d));
+    }
+
+}
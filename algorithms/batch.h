@@ -0,0 +1,48 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include "voronoidiagram.h"
+
+#include <memory>
+
+namespace Voronoi {
+    /**
+     * @brief The BatchWorker struct, the state of a thread of computeVoronoiDiagrams: the workspace of the sweep,
+     * the DCEL of the diagram being computed, and the elements of the diagrams computed by the thread,
+     * with their own indices, until they are moved in the DCEL of the batch
+     */
+    struct BatchWorker {
+        SweepWorkspace workspace;
+        DCEL dcel;
+        std::vector<Vertex> vertexs;
+        std::vector<HalfEdge> halfEdges;
+        std::vector<Face> faces;
+    };
+
+    /**
+     * @brief The DiagramBatch struct, the diagrams of many sets of sites stored in a single DCEL.
+     * The diagram i is made of the faces faceOffsets[i] ... faceOffsets[i+1] - 1, and of the halfEdges and the vertexs
+     * in the ranges given in the same way by halfEdgeOffsets and vertexOffsets; its indices refer to the whole DCEL.
+     * The workers are kept with their memory, so a batch reused for similar inputs allocates only for larger ones
+     */
+    struct DiagramBatch {
+        DCEL dcel;
+        std::vector<size_t> faceOffsets, halfEdgeOffsets, vertexOffsets;
+        std::vector<std::unique_ptr<BatchWorker>> workers;
+
+        size_t size() const;
+    };
+
+    void computeVoronoiDiagrams(const std::vector<std::vector<cg3::Point2Dd>>& pointSets,
+                                const std::vector<cg3::BoundingBox2D>& boundingBoxes, DiagramBatch& batch, int nThreads = 0);
+
+    /**
+     * @brief DiagramBatch::size
+     * @return the number of diagrams of the batch
+     */
+    inline size_t DiagramBatch::size() const {
+        return faceOffsets.empty() ? 0 : faceOffsets.size() - 1;
+    }
+}
+
+#endif // BATCH_H
@@ -0,0 +1,492 @@
+#include "cellrebuild.h"
+
+#include "voronoidiagram.h"
+
+#include <cmath>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace Voronoi {
+
+    namespace internal {
+
+        /**
+         * @brief clipCell Sutherland-Hodgman clipping of the convex polygon with the half-plane of the points
+         * nearer to site than to other. The new edge is tagged with tag
+         */
+        void clipCell(CellPolygon& polygon, const cg3::Point2Dd& site, const cg3::Point2Dd& other, size_t tag, CellPolygon& buffer) {
+            //signed distance (scaled) from the bisector, positive on the side of other
+            double nx = other.x() - site.x(), ny = other.y() - site.y();
+            double mx = (other.x() + site.x())/2, my = (other.y() + site.y())/2;
+            auto side = [&](const cg3::Point2Dd& p) {
+                return (p.x() - mx)*nx + (p.y() - my)*ny;
+            };
+
+            buffer.clear();
+            const size_t n = polygon.size();
+            for(size_t i = 0; i < n; i++) {
+                const CellCorner& a = polygon[i];
+                const CellCorner& b = polygon[(i+1) % n];
+                double da = side(a.point), db = side(b.point);
+                if(da <= 0) {
+                    if(db <= 0)
+                        buffer.push_back(a);
+                    else {
+                        double t = da/(da - db);
+                        buffer.push_back(a);
+                        CellCorner x = {cg3::Point2Dd(a.point.x() + t*(b.point.x() - a.point.x()),
+                                                      a.point.y() + t*(b.point.y() - a.point.y())), tag};
+                        if(da < 0)
+                            buffer.push_back(x);
+                        else
+                            buffer.back().tag = tag;
+                    }
+                } else if(db <= 0) {
+                    double t = da/(da - db);
+                    if(db < 0) {
+                        CellCorner y = {cg3::Point2Dd(a.point.x() + t*(b.point.x() - a.point.x()),
+                                                      a.point.y() + t*(b.point.y() - a.point.y())), a.tag};
+                        buffer.push_back(y);
+                    }
+                }
+            }
+            polygon.swap(buffer);
+        }
+
+        /**
+         * @brief boxPolygon the polygon of the whole box, the cell clipped by the bisectors
+         */
+        void boxPolygon(const cg3::BoundingBox2D& box, CellPolygon& polygon) {
+            const cg3::Point2Dd& min = box.min();
+            const cg3::Point2Dd& max = box.max();
+            CellCorner corners[4] = {{min, boxSideTag(0)},
+                                     {cg3::Point2Dd(max.x(), min.y()), boxSideTag(1)},
+                                     {max, boxSideTag(2)},
+                                     {cg3::Point2Dd(min.x(), max.y()), boxSideTag(3)}};
+            polygon.assign(corners, corners + 4);
+        }
+
+        /**
+         * @brief vertexPosition computes the position of a vertex from its constraints, so the same vertex
+         * gets the same coordinates from all the cells around it
+         */
+        cg3::Point2Dd vertexPosition(const VertexKey& key, const std::vector<Face>& faces, const cg3::BoundingBox2D& box) {
+            size_t sites[3], sides[3], nSites = 0, nSides = 0;
+            for(size_t tag : key) {
+                if(isBoxSideTag(tag))
+                    sides[nSides++] = tag;
+                else if(tag != std::numeric_limits<size_t>::max())
+                    sites[nSites++] = tag;
+            }
+
+            if(nSites == 3) {
+                //circumcenter, relatively to the first site
+                cg3::Point2Dd a = faces[sites[0]].getSite(), b = faces[sites[1]].getSite(), c = faces[sites[2]].getSite();
+                double bx = b.x() - a.x(), by = b.y() - a.y(), cx = c.x() - a.x(), cy = c.y() - a.y();
+                double d = 2*(bx*cy - by*cx), b2 = bx*bx + by*by, c2 = cx*cx + cy*cy;
+                return cg3::Point2Dd(a.x() + (cy*b2 - by*c2)/d, a.y() + (bx*c2 - cx*b2)/d);
+            }
+            if(nSites == 2) {
+                //intersection of the bisector with the side of the box
+                cg3::Point2Dd a = faces[sites[0]].getSite(), b = faces[sites[1]].getSite();
+                double mx = (a.x() + b.x())/2, my = (a.y() + b.y())/2, nx = b.x() - a.x(), ny = b.y() - a.y();
+                int side = boxSide(sides[0]);
+                if(side == 0 || side == 2) {
+                    double y = side == 0 ? box.min().y() : box.max().y();
+                    double x = nx != 0 ? mx - (y - my)*ny/nx : mx;
+                    return cg3::Point2Dd(std::min(std::max(x, box.min().x()), box.max().x()), y);
+                } else {
+                    double x = side == 1 ? box.max().x() : box.min().x();
+                    double y = ny != 0 ? my - (x - mx)*nx/ny : my;
+                    return cg3::Point2Dd(x, std::min(std::max(y, box.min().y()), box.max().y()));
+                }
+            }
+            //corner of the box
+            int s1 = boxSide(sides[0]), s2 = boxSide(sides[1]);
+            bool top = s1 == 2 || s2 == 2, right = s1 == 1 || s2 == 1;
+            return cg3::Point2Dd(right ? box.max().x() : box.min().x(), top ? box.max().y() : box.min().y());
+        }
+
+        /**
+         * @brief boxSideOf the side of the box where the halfEdge e lies
+         */
+        int boxSideOf(const DCEL& dcel, size_t e, const cg3::BoundingBox2D& box) {
+            const std::vector<HalfEdge>& edges = dcel.getHalfEdges();
+            cg3::Point2Dd a = dcel.getVertexCoordinates(edges[e].getOriginID());
+            cg3::Point2Dd b = dcel.getVertexCoordinates(edges[dcel.getTwinID(e)].getOriginID());
+            double x = (a.x() + b.x())/2, y = (a.y() + b.y())/2;
+            double distances[4] = {y - box.min().y(), box.max().x() - x, box.max().y() - y, x - box.min().x()};
+            return static_cast<int>(std::min_element(distances, distances + 4) - distances);
+        }
+
+    }
+
+    /**
+     * @brief locateSite finds the cell containing p, with a greedy walk on the neighbours of the cells
+     * towards the sites nearer to p (the walk always reaches the nearest site). The walk starts from the hint
+     * or from the nearest of a sample of the faces, so it is short also for a far hint
+     * @param dcel: a diagram with closed cells
+     * @param p
+     * @param hint: the face where the walk starts, if it has a cell
+     * @return the face of the nearest site to p, std::numeric_limits<size_t>::max() if no face has a cell
+     */
+    size_t locateSite(const DCEL& dcel, const cg3::Point2Dd& p, size_t hint) {
+        const std::vector<Face>& faces = dcel.getFaces();
+        const std::vector<HalfEdge>& edges = dcel.getHalfEdges();
+        const size_t null = std::numeric_limits<size_t>::max();
+
+        auto squaredDistance = [&p](const cg3::Point2Dd& site) {
+            return (site.x() - p.x())*(site.x() - p.x()) + (site.y() - p.y())*(site.y() - p.y());
+        };
+
+        //The walk starts from the nearest to p among the hint and about cbrt(n) faces spread over the DCEL
+        size_t current = null;
+        double distance = std::numeric_limits<double>::max();
+        if(hint < faces.size() && faces[hint].getIncidEdgeID() != null) {
+            current = hint;
+            distance = squaredDistance(faces[hint].getSite());
+        }
+        const size_t stride = std::max<size_t>(1, faces.size()/static_cast<size_t>(std::cbrt(static_cast<double>(faces.size())) + 1));
+        for(size_t f = stride/2; f < faces.size(); f += stride) {
+            if(faces[f].getIncidEdgeID() != null && squaredDistance(faces[f].getSite()) < distance) {
+                current = f;
+                distance = squaredDistance(faces[f].getSite());
+            }
+        }
+        if(current == null) {
+            current = 0;
+            while(current < faces.size() && faces[current].getIncidEdgeID() == null)
+                current++;
+            if(current == faces.size())
+                return null;
+            distance = squaredDistance(faces[current].getSite());
+        }
+
+        while(true) {
+            size_t best = current, start = faces[current].getIncidEdgeID(), e = start;
+            do {
+                size_t neighbour = edges[dcel.getTwinID(e)].getFaceID();
+                if(neighbour != null) {
+                    double d = squaredDistance(faces[neighbour].getSite());
+                    if(d < distance) {
+                        distance = d;
+                        best = neighbour;
+                    }
+                }
+                e = edges[e].getNextID();
+            } while(e != start && e != null);
+            if(best == current)
+                return current;
+            current = best;
+        }
+    }
+
+    /**
+     * @brief findNeighbours the faces adjacent to the cell of face
+     * @param dcel
+     * @param face
+     * @param neighbours: output, the faces on the other side of the edges of the cell (the box is not included)
+     */
+    void findNeighbours(const DCEL& dcel, size_t face, std::vector<size_t>& neighbours) {
+        const std::vector<HalfEdge>& edges = dcel.getHalfEdges();
+        const size_t null = std::numeric_limits<size_t>::max();
+
+        neighbours.clear();
+        size_t start = dcel.getFaces()[face].getIncidEdgeID(), e = start;
+        if(start == null)
+            return;
+        do {
+            size_t neighbour = edges[dcel.getTwinID(e)].getFaceID();
+            if(neighbour != null)
+                neighbours.push_back(neighbour);
+            e = edges[e].getNextID();
+        } while(e != start && e != null);
+    }
+
+    /**
+     * @brief rebuildCells replaces the cells of a region of the diagram, leaving the rest of the DCEL untouched.
+     * The new cell of each face in cells is the box clipped by the bisectors with its old neighbours, with the faces of the region
+     * adjacent to them and with the faces of the region that had no cell (which are clipped by all the region).
+     * The faces in emptiedCells lose their cells. The region must contain every face whose cell changes:
+     * the edges between the region and the other cells are kept, with their halfEdges and vertexs.
+     * The halfEdges and the vertexs of the old cells that are not used anymore are removed from the DCEL, their slots are reused
+     * @param dcel: a diagram with closed cells, as the one computed by fortuneAlgorithm
+     * @param boundingBox: the box of the diagram
+     * @param cells: the faces whose cells are recomputed
+     * @param emptiedCells: the faces whose cells are removed
+     * @return false if the region was too small (e.g. a site moved past its old neighbours, or four sites on a circle):
+     * a new cell reached a face outside the region or lost an edge towards it, or two cells of the region did not agree
+     * on their edge or its vertexs. The whole diagram is then computed again with recomputeCells
+     */
+    bool rebuildCells(DCEL& dcel, const cg3::BoundingBox2D& boundingBox,
+                      const std::vector<size_t>& cells, const std::vector<size_t>& emptiedCells) {
+        std::vector<HalfEdge>& edges = dcel.getHalfEdges();
+        std::vector<Vertex>& vertexs = dcel.getVertexs();
+        std::vector<Face>& faces = dcel.getFaces();
+        const size_t null = std::numeric_limits<size_t>::max();
+        dcel.fitOrigin(boundingBox);
+
+        std::unordered_set<size_t> region(cells.begin(), cells.end()), emptied(emptiedCells.begin(), emptiedCells.end());
+        region.insert(emptiedCells.begin(), emptiedCells.end());
+
+        //Old boundaries of the region: vertexs by key, kept edges towards the rest of the diagram, removed halfEdges
+        std::map<internal::VertexKey, size_t> oldVertexs;
+        std::unordered_map<std::pair<size_t, size_t>, size_t, internal::PairHash> keptEdges;
+        std::unordered_set<size_t> removed;
+        std::vector<std::vector<size_t>> oldNeighbours(cells.size());
+        std::unordered_map<size_t, std::vector<size_t>> adjacentCells;
+        std::vector<size_t> newCells;
+        std::unordered_map<size_t, size_t> cellIndex;
+        size_t nCellKeptEdges = 0;
+        for(size_t i = 0; i < cells.size(); i++) {
+            cellIndex[cells[i]] = i;
+            if(faces[cells[i]].getIncidEdgeID() == null)
+                newCells.push_back(cells[i]);
+        }
+
+        for(size_t face : region) {
+            size_t start = faces[face].getIncidEdgeID(), e = start;
+            if(start == null)
+                continue;
+            size_t prevTag = internal::edgeTag(dcel, edges[e].getPrevID(), boundingBox);
+            do {
+                size_t tag = internal::edgeTag(dcel, e, boundingBox);
+                oldVertexs[internal::vertexKey(face, prevTag, tag)] = edges[e].getOriginID();
+                if(!internal::isBoxSideTag(tag) && region.count(tag) == 0) {
+                    keptEdges[std::make_pair(face, tag)] = e;
+                    nCellKeptEdges += cellIndex.count(face);
+                } else {
+                    removed.insert(e);
+                    removed.insert(dcel.getTwinID(e));
+                }
+                if(!internal::isBoxSideTag(tag) && cellIndex.count(face)) {
+                    oldNeighbours[cellIndex[face]].push_back(tag);
+                    adjacentCells[tag].push_back(face);
+                }
+                prevTag = tag;
+                e = edges[e].getNextID();
+            } while(e != start && e != null);
+        }
+
+        //The halfEdges outside the box next to the removed ones, they will be linked to the new ones
+        std::unordered_map<size_t, size_t> outerFrom, outerTo;
+        for(size_t e : removed) {
+            if(edges[e].getFaceID() != null)
+                continue;
+            size_t next = edges[e].getNextID(), prev = edges[e].getPrevID();
+            if(next != null && removed.count(next) == 0)
+                outerFrom[edges[next].getOriginID()] = next;
+            if(prev != null && removed.count(prev) == 0)
+                outerTo[edges[e].getOriginID()] = prev;
+        }
+
+        //The vertexs used by the new cells get again an incident halfEdge, the others stay removed
+        for(const std::pair<const internal::VertexKey, size_t>& v : oldVertexs)
+            vertexs[v.second].setIncidEdge(null);
+        for(size_t e : removed) {
+            if(e % 2 == 0)
+                dcel.removeHalfEdgePair(e);
+        }
+        for(size_t face : emptied)
+            faces[face].setIncidEdge(null);
+
+        //New cells
+        std::map<internal::VertexKey, size_t> newVertexs;
+        std::unordered_map<std::pair<size_t, size_t>, size_t, internal::PairHash> newEdges;
+        std::vector<size_t> newOuterEdges;
+        internal::CellPolygon polygon, buffer;
+        std::vector<size_t> polygonVertexs, polygonEdges, others;
+        size_t nKeptEdges = 0;
+        for(size_t i = 0; i < cells.size(); i++) {
+            size_t face = cells[i];
+            const cg3::Point2Dd site = faces[face].getSite();
+
+            //The new neighbours of a cell are its old ones or faces of the region near them
+            others.clear();
+            if(oldNeighbours[i].empty())
+                others.assign(cells.begin(), cells.end());
+            for(size_t neighbour : oldNeighbours[i]) {
+                if(emptied.count(neighbour) == 0)
+                    others.push_back(neighbour);
+                const std::vector<size_t>& adjacent = adjacentCells[neighbour];
+                others.insert(others.end(), adjacent.begin(), adjacent.end());
+            }
+            others.insert(others.end(), newCells.begin(), newCells.end());
+            std::sort(others.begin(), others.end());
+            others.erase(std::unique(others.begin(), others.end()), others.end());
+
+            internal::boxPolygon(boundingBox, polygon);
+            for(size_t j = 0; j < others.size() && !polygon.empty(); j++) {
+                if(others[j] != face && faces[others[j]].getSite() != site)
+                    internal::clipCell(polygon, site, faces[others[j]].getSite(), others[j], buffer);
+            }
+
+            faces[face].setIncidEdge(null);
+            if(polygon.size() < 3)
+                continue;
+
+            //Vertexs: the old ones are kept, the new ones are shared through their keys
+            const size_t n = polygon.size();
+            polygonVertexs.resize(n);
+            for(size_t j = 0; j < n; j++) {
+                internal::VertexKey key = internal::vertexKey(face, polygon[(j + n - 1) % n].tag, polygon[j].tag);
+                std::map<internal::VertexKey, size_t>::const_iterator it = oldVertexs.find(key);
+                if(it == oldVertexs.end()) {
+                    it = newVertexs.find(key);
+                    if(it == newVertexs.end())
+                        it = newVertexs.insert(std::make_pair(key, dcel.addVertex(dcel.makeVertex(internal::vertexPosition(key, faces, boundingBox))))).first;
+                }
+                polygonVertexs[j] = it->second;
+            }
+
+            //HalfEdges: the ones towards the rest of the diagram are kept, the ones between two cells of the region are shared
+            polygonEdges.resize(n);
+            for(size_t j = 0; j < n; j++) {
+                size_t tag = polygon[j].tag, e;
+                if(internal::isBoxSideTag(tag)) {
+                    e = dcel.addHalfEdgePair(face, null);
+                    edges[e+1].setOrigin(polygonVertexs[(j+1) % n]);
+                    outerFrom[polygonVertexs[(j+1) % n]] = e+1;
+                    newOuterEdges.push_back(e+1);
+                } else if(region.count(tag) == 0 && keptEdges.count(std::make_pair(face, tag))) {
+                    e = keptEdges[std::make_pair(face, tag)];
+                    nKeptEdges++;
+                } else {
+                    std::unordered_map<std::pair<size_t, size_t>, size_t, internal::PairHash>::const_iterator it =
+                            newEdges.find(std::make_pair(face, tag));
+                    if(it == newEdges.end()) {
+                        e = dcel.addHalfEdgePair(face, tag);
+                        newEdges[std::make_pair(face, tag)] = e;
+                        newEdges[std::make_pair(tag, face)] = e+1;
+                    } else
+                        e = it->second;
+                }
+                edges[e].setOrigin(polygonVertexs[j]);
+                vertexs[polygonVertexs[j]].setIncidEdge(e);
+                polygonEdges[j] = e;
+            }
+            for(size_t j = 0; j < n; j++) {
+                edges[polygonEdges[j]].setNext(polygonEdges[(j+1) % n]);
+                edges[polygonEdges[(j+1) % n]].setPrev(polygonEdges[j]);
+            }
+            faces[face].setIncidEdge(polygonEdges[0]);
+        }
+
+        //Each new cell must have been matched by its neighbours: the twin of each halfEdge was built by them, and starts
+        //where the next halfEdge starts. The edges towards the rest of the diagram must all still be there
+        bool isConsistent = nKeptEdges == nCellKeptEdges;
+        for(size_t i = 0; i < cells.size() && isConsistent; i++) {
+            size_t start = faces[cells[i]].getIncidEdgeID(), e = start;
+            if(start == null)
+                continue;
+            do {
+                size_t twin = dcel.getTwinID(e);
+                if(edges[twin].getOriginID() == null || edges[edges[e].getNextID()].getOriginID() != edges[twin].getOriginID())
+                    isConsistent = false;
+                e = edges[e].getNextID();
+            } while(e != start && isConsistent);
+        }
+
+        //The new halfEdges outside the box are linked to the ones starting where they end
+        for(size_t outer : newOuterEdges) {
+            std::unordered_map<size_t, size_t>::const_iterator it = outerFrom.find(edges[dcel.getTwinID(outer)].getOriginID());
+            if(it != outerFrom.end()) {
+                edges[outer].setNext(it->second);
+                edges[it->second].setPrev(outer);
+            }
+        }
+        for(const std::pair<const size_t, size_t>& to : outerTo) {
+            std::unordered_map<size_t, size_t>::const_iterator it = outerFrom.find(to.first);
+            if(it != outerFrom.end()) {
+                edges[to.second].setNext(it->second);
+                edges[it->second].setPrev(to.second);
+            }
+        }
+
+        //The old vertexs not used by the new cells are removed
+        std::vector<size_t> unused;
+        for(const std::pair<const internal::VertexKey, size_t>& v : oldVertexs) {
+            if(vertexs[v.second].getIncidEdgeID() == null)
+                unused.push_back(v.second);
+        }
+        std::sort(unused.begin(), unused.end());
+        unused.erase(std::unique(unused.begin(), unused.end()), unused.end());
+        for(size_t v : unused)
+            dcel.removeVertex(v);
+
+        if(!isConsistent)
+            recomputeCells(dcel, boundingBox, cells, emptiedCells);
+        return isConsistent;
+    }
+
+    /**
+     * @brief recomputeCells computes again the whole diagram with fortuneAlgorithm, keeping the indices of the faces:
+     * the faces in cells, the ones with a cell and their coincident faces are swept, the faces in emptiedCells and
+     * the others get no cell. The rings of the coincident faces are the ones found by the sweep, the removed faces stay removed
+     * @param dcel: a diagram whose faces with a cell are the sites, the halfEdges and the vertexs are replaced
+     * @param boundingBox: the box of the diagram
+     * @param cells: faces that get a cell even if they have none
+     * @param emptiedCells: faces that lose their cell
+     */
+    void recomputeCells(DCEL& dcel, const cg3::BoundingBox2D& boundingBox,
+                        const std::vector<size_t>& cells, const std::vector<size_t>& emptiedCells) {
+        const size_t null = std::numeric_limits<size_t>::max();
+        std::vector<Face> oldFaces = dcel.getFaces();
+        std::vector<char> hasCell(oldFaces.size(), 0);
+        std::vector<size_t> removed;
+        for(size_t f = 0; f < oldFaces.size(); f++) {
+            if(dcel.isFaceRemoved(f))
+                removed.push_back(f);
+            else
+                hasCell[f] = oldFaces[f].getIncidEdgeID() != null || dcel.getCoincidentFace(f) != f;
+        }
+        for(size_t face : cells)
+            hasCell[face] = 1;
+        for(size_t face : emptiedCells)
+            hasCell[face] = 0;
+
+        std::vector<size_t> alive;
+        std::vector<cg3::Point2Dd> sites;
+        for(size_t f = 0; f < oldFaces.size(); f++) {
+            if(hasCell[f]) {
+                alive.push_back(f);
+                sites.push_back(oldFaces[f].getSite());
+            }
+        }
+
+        dcel.clear();
+        fortuneAlgorithm(sites, dcel, boundingBox);
+
+        std::vector<HalfEdge>& edges = dcel.getHalfEdges();
+        std::vector<Face>& faces = dcel.getFaces();
+        for(size_t e = 0; e < edges.size(); e++) {
+            if(edges[e].getFaceID() != null)
+                edges[e].setFace(alive[edges[e].getFaceID()]);
+        }
+
+        //The sites without a cell are linked to the face with the cell of their ring, once the faces are back in place
+        std::vector<std::pair<size_t, size_t>> coincident;
+        for(size_t i = 0; i < alive.size(); i++) {
+            if(faces[i].getIncidEdgeID() != null || dcel.getCoincidentFace(i) == i)
+                continue;
+            size_t holder = dcel.getCoincidentFace(i);
+            while(faces[holder].getIncidEdgeID() == null)
+                holder = dcel.getCoincidentFace(holder);
+            coincident.push_back(std::make_pair(alive[holder], alive[i]));
+        }
+        for(size_t i = 0; i < alive.size(); i++)
+            dcel.unlinkCoincidentFace(i);
+
+        for(Face& face : oldFaces)
+            face.setIncidEdge(null);
+        for(size_t i = 0; i < alive.size(); i++)
+            oldFaces[alive[i]].setIncidEdge(faces[i].getIncidEdgeID());
+        faces.swap(oldFaces);
+        for(const std::pair<size_t, size_t>& link : coincident)
+            dcel.linkCoincidentFaces(link.first, link.second);
+        for(size_t face : removed)
+            dcel.removeFace(face);
+    }
+
+}
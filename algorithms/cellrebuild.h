@@ -0,0 +1,100 @@
+#ifndef CELLREBUILD_H
+#define CELLREBUILD_H
+
+#include "../data_structures/dcel.h"
+#include <cg3/geometry/2d/bounding_box2d.h>
+
+#include <algorithm>
+#include <array>
+#include <functional>
+
+namespace Voronoi {
+
+    namespace internal {
+
+        /**
+         * Each edge of a cell is tagged with the constraint it comes from: the face on its other side,
+         * or a side of the bounding box (the sides are numbered counterclockwise from the bottom one)
+         */
+        inline size_t boxSideTag(int side) {
+            return std::numeric_limits<size_t>::max() - 1 - static_cast<size_t>(side);
+        }
+
+        inline bool isBoxSideTag(size_t tag) {
+            return tag != std::numeric_limits<size_t>::max() && tag >= boxSideTag(3);
+        }
+
+        inline int boxSide(size_t tag) {
+            return static_cast<int>(std::numeric_limits<size_t>::max() - 1 - tag);
+        }
+
+        /**
+         * A vertex is identified by the three constraints that meet in it, sorted.
+         * The corners of the box, which belong to a single cell whichever it is, use the null face instead of the cell
+         */
+        typedef std::array<size_t, 3> VertexKey;
+
+        inline VertexKey vertexKey(size_t face, size_t tag1, size_t tag2) {
+            VertexKey key = {{isBoxSideTag(tag1) && isBoxSideTag(tag2) ? std::numeric_limits<size_t>::max() : face, tag1, tag2}};
+            std::sort(key.begin(), key.end());
+            return key;
+        }
+
+        struct PairHash {
+            size_t operator()(const std::pair<size_t, size_t>& p) const {
+                return std::hash<size_t>()(p.first*0x9E3779B97F4A7C15ULL ^ p.second);
+            }
+        };
+
+        struct VertexKeyHash {
+            size_t operator()(const VertexKey& key) const {
+                return std::hash<size_t>()(((key[0]*0x9E3779B97F4A7C15ULL) ^ key[1])*0x9E3779B97F4A7C15ULL ^ key[2]);
+            }
+        };
+
+        /**
+         * @brief The CellCorner struct, a vertex of a cell polygon, with the tag of the edge from it to the next vertex
+         */
+        struct CellCorner {
+            cg3::Point2Dd point;
+            size_t tag;
+        };
+
+        typedef std::vector<CellCorner> CellPolygon;
+
+        void boxPolygon(const cg3::BoundingBox2D& box, CellPolygon& polygon);
+        void clipCell(CellPolygon& polygon, const cg3::Point2Dd& site, const cg3::Point2Dd& other, size_t tag, CellPolygon& buffer);
+        cg3::Point2Dd vertexPosition(const VertexKey& key, const std::vector<Face>& faces, const cg3::BoundingBox2D& box);
+        int boxSideOf(const DCEL& dcel, size_t e, const cg3::BoundingBox2D& box);
+
+        inline size_t edgeTag(const DCEL& dcel, size_t e, const cg3::BoundingBox2D& box) {
+            size_t face = dcel.getHalfEdges()[dcel.getTwinID(e)].getFaceID();
+            return face != std::numeric_limits<size_t>::max() ? face : boxSideTag(boxSideOf(dcel, e, box));
+        }
+
+        /**
+         * @brief hasCoincidentCell true if a face of the ring of face (face included) has a cell and the same site
+         */
+        inline bool hasCoincidentCell(const DCEL& dcel, size_t face) {
+            const std::vector<Face>& faces = dcel.getFaces();
+            size_t f = face;
+            do {
+                if(faces[f].getIncidEdgeID() != std::numeric_limits<size_t>::max())
+                    return faces[f].getSite() == faces[face].getSite();
+                f = dcel.getCoincidentFace(f);
+            } while(f != face && f != std::numeric_limits<size_t>::max());
+            return false;
+        }
+
+    }
+
+    size_t locateSite(const DCEL& dcel, const cg3::Point2Dd& p, size_t hint = std::numeric_limits<size_t>::max());
+    void findNeighbours(const DCEL& dcel, size_t face, std::vector<size_t>& neighbours);
+    bool rebuildCells(DCEL& dcel, const cg3::BoundingBox2D& boundingBox,
+                      const std::vector<size_t>& cells, const std::vector<size_t>& emptiedCells);
+    void recomputeCells(DCEL& dcel, const cg3::BoundingBox2D& boundingBox,
+                        const std::vector<size_t>& cells, const std::vector<size_t>& emptiedCells);
+
+}
+
+#endif // CELLREBUILD_H
@@ -0,0 +1,344 @@
+#include "clipping.h"
+
+#include <algorithm>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+//Number of pairs of halfEdges clipped by each chunk
+#define CLIPPING_CHUNK_SIZE 4096
+//Under this number of pairs of halfEdges a single thread is used
+#define CLIPPING_PARALLEL_MIN_SIZE 65536
+
+//Sides of the bounding box, in counterclockwise order
+#define SIDE_NONE -1
+#define SIDE_BOTTOM 0
+#define SIDE_RIGHT 1
+#define SIDE_TOP 2
+#define SIDE_LEFT 3
+
+namespace Voronoi {
+
+    namespace internal {
+
+        /**
+         * @brief clipLine Liang-Barsky clipping of the line p + t*d, with t in [t0, t1], against the box.
+         * Infinite values of t0 and t1 are allowed, so rays and lines are handled as segments
+         * @param t0, t1: the interval of the parameter, restricted to the part inside the box
+         * @param side0, side1: the sides of the box where the interval has been cut, SIDE_NONE if it hasn't
+         * @return false if the line doesn't cross the box
+         */
+        inline bool clipLine(double px, double py, double dx, double dy, const cg3::BoundingBox2D& box,
+                             double& t0, double& t1, int& side0, int& side1) {
+            side0 = side1 = SIDE_NONE;
+
+            if(dx != 0) {
+                double ta = (box.min().x() - px)/dx, tb = (box.max().x() - px)/dx;
+                int sa = dx > 0 ? SIDE_LEFT : SIDE_RIGHT, sb = dx > 0 ? SIDE_RIGHT : SIDE_LEFT;
+                if(dx < 0)
+                    std::swap(ta, tb);
+                if(ta > t0) { t0 = ta; side0 = sa; }
+                if(tb < t1) { t1 = tb; side1 = sb; }
+            } else if(px < box.min().x() || px > box.max().x())
+                return false;
+
+            if(dy != 0) {
+                double ta = (box.min().y() - py)/dy, tb = (box.max().y() - py)/dy;
+                int sa = dy > 0 ? SIDE_BOTTOM : SIDE_TOP, sb = dy > 0 ? SIDE_TOP : SIDE_BOTTOM;
+                if(dy < 0)
+                    std::swap(ta, tb);
+                if(ta > t0) { t0 = ta; side0 = sa; }
+                if(tb < t1) { t1 = tb; side1 = sb; }
+            } else if(py < box.min().y() || py > box.max().y())
+                return false;
+
+            return t0 <= t1;
+        }
+
+        /**
+         * @brief pointOnSide the point p + t*d, which lies on side, with the coordinate of the side set exactly
+         * @return the position of the point along the boundary of the box, counterclockwise from the min corner
+         */
+        inline double pointOnSide(double px, double py, double dx, double dy, double t, int side,
+                                  const cg3::BoundingBox2D& box, cg3::Point2Dd& point) {
+            double width = box.max().x() - box.min().x(), height = box.max().y() - box.min().y();
+            double x = std::min(std::max(px + t*dx, box.min().x()), box.max().x());
+            double y = std::min(std::max(py + t*dy, box.min().y()), box.max().y());
+            switch(side) {
+                case SIDE_BOTTOM:
+                    point.set(x, box.min().y());
+                    return x - box.min().x();
+                case SIDE_RIGHT:
+                    point.set(box.max().x(), y);
+                    return width + y - box.min().y();
+                case SIDE_TOP:
+                    point.set(x, box.max().y());
+                    return width + height + box.max().x() - x;
+                default:
+                    point.set(box.min().x(), y);
+                    return 2*width + height + box.max().y() - y;
+            }
+        }
+
+        /**
+         * @brief edgeLine the line of the pair of halfEdges (e, e^1) as p + t*d, with t in [t0, t1], oriented as e.
+         * The halfEdges without an origin are rays (or lines) along the bisector of their sites.
+         * The vertexs far from the box (farther than its size) are only projected on the bisector: their coordinates
+         * can be rounded a lot (as floats with VORONOI_FLOAT_COORDINATES), and they only bound the part of the edge outside the box
+         * @return false if the pair is not part of the diagram
+         */
+        inline bool edgeLine(const DCEL& dcel, size_t e, const cg3::BoundingBox2D& box,
+                             double& px, double& py, double& dx, double& dy, double& t0, double& t1) {
+            const std::vector<HalfEdge>& edges = dcel.getHalfEdges();
+            const std::vector<Face>& faces = dcel.getFaces();
+            const size_t null = std::numeric_limits<size_t>::max();
+            size_t twin = dcel.getTwinID(e);
+            size_t origin = edges[e].getOriginID(), end = edges[twin].getOriginID();
+
+            const double margin = std::max(box.max().x() - box.min().x(), box.max().y() - box.min().y());
+            auto isNear = [&](const cg3::Point2Dd& v) {
+                return v.x() >= box.min().x() - margin && v.x() <= box.max().x() + margin &&
+                       v.y() >= box.min().y() - margin && v.y() <= box.max().y() + margin;
+            };
+            cg3::Point2Dd a, b;
+            bool nearOrigin = false, nearEnd = false;
+            if(origin != null) {
+                a = dcel.getVertexCoordinates(origin);
+                nearOrigin = isNear(a);
+            }
+            if(end != null) {
+                b = dcel.getVertexCoordinates(end);
+                nearEnd = isNear(b);
+            }
+
+            bool bisector = edges[e].getFaceID() != null && edges[twin].getFaceID() != null;
+            if(bisector) {
+                //The face of e is on its left, so e goes along the bisector with the site of its twin on the right
+                cg3::Point2Dd left = faces[edges[e].getFaceID()].getSite(), right = faces[edges[twin].getFaceID()].getSite();
+                dx = left.y() - right.y();
+                dy = right.x() - left.x();
+                px = (left.x() + right.x())/2;
+                py = (left.y() + right.y())/2;
+                bisector = dx != 0 || dy != 0;
+            }
+            if((origin != null && end != null && nearOrigin && nearEnd) || (!bisector && origin != null && end != null)) {
+                px = a.x(); py = a.y();
+                dx = b.x() - a.x(); dy = b.y() - a.y();
+                t0 = 0; t1 = 1;
+                return true;
+            }
+            if(!bisector)
+                return false;
+
+            auto projection = [&](const cg3::Point2Dd& v) {
+                return ((v.x() - px)*dx + (v.y() - py)*dy)/(dx*dx + dy*dy);
+            };
+            t0 = origin != null ? projection(a) : -std::numeric_limits<double>::infinity();
+            t1 = end != null ? projection(b) : std::numeric_limits<double>::infinity();
+            if(nearOrigin) {
+                px = a.x(); py = a.y();
+                t1 -= t0;
+                t0 = 0;
+            } else if(nearEnd) {
+                px = b.x(); py = b.y();
+                t0 -= t1;
+                t1 = 0;
+            }
+            return true;
+        }
+
+    }
+
+    /**
+     * @brief clipDiagram clips the diagram stored in dcel to the bounding box.
+     * The pairs of halfEdges are clipped by chunks in parallel with the Liang-Barsky algorithm, the unbounded ones
+     * as rays or lines along the bisectors of their sites. The parts outside the box are removed (halfEdges and vertexs
+     * are left in the DCEL without origin and incident halfEdge), new vertexs are added where the edges cross the box,
+     * and the boundary of the box is added as halfEdges, so that the cells touching it are closed.
+     * The halfEdges of the box have the outside of the box (no face) on the right
+     * @param dcel: a diagram computed by fortuneAlgorithm, with its faces
+     * @param boundingBox
+     */
+    void clipDiagram(DCEL& dcel, const cg3::BoundingBox2D& boundingBox) {
+        ClippingBuffers buffers;
+        clipDiagram(dcel, boundingBox, buffers);
+    }
+
+    /**
+     * @brief clipDiagram clips the diagram stored in dcel to the bounding box, as clipDiagram,
+     * with the offsets of the chunks and the points on the boundary of the box in buffers
+     * @param dcel: a diagram computed by fortuneAlgorithm, with its faces
+     * @param boundingBox
+     * @param buffers: resized as needed, their memory is kept for the next clippings
+     */
+    void clipDiagram(DCEL& dcel, const cg3::BoundingBox2D& boundingBox, ClippingBuffers& buffers) {
+        std::vector<HalfEdge>& edges = dcel.getHalfEdges();
+        std::vector<Vertex>& vertexs = dcel.getVertexs();
+        std::vector<Face>& faces = dcel.getFaces();
+        const size_t null = std::numeric_limits<size_t>::max();
+        dcel.fitOrigin(boundingBox);
+        const size_t nPairs = edges.size()/2, nVertexs = vertexs.size();
+        const size_t nChunks = (nPairs + CLIPPING_CHUNK_SIZE - 1)/CLIPPING_CHUNK_SIZE;
+        const long long nChunksSigned = static_cast<long long>(nChunks);
+
+        int nThreads = 1;
+        #ifdef _OPENMP
+        if(nPairs >= CLIPPING_PARALLEL_MIN_SIZE)
+            nThreads = omp_get_max_threads();
+        #endif
+
+        //First pass: number of new vertexs of each chunk
+        std::vector<size_t>& chunkOffsets = buffers.chunkOffsets;
+        chunkOffsets.assign(nChunks + 1, 0);
+        #pragma omp parallel for num_threads(nThreads) if(nThreads > 1)
+        for(long long c = 0; c < nChunksSigned; c++) {
+            size_t end = std::min(nPairs, static_cast<size_t>(c + 1)*CLIPPING_CHUNK_SIZE), count = 0;
+            for(size_t pair = static_cast<size_t>(c)*CLIPPING_CHUNK_SIZE; pair < end; pair++) {
+                double px, py, dx, dy, t0, t1;
+                int side0, side1;
+                if(internal::edgeLine(dcel, 2*pair, boundingBox, px, py, dx, dy, t0, t1) &&
+                        internal::clipLine(px, py, dx, dy, boundingBox, t0, t1, side0, side1))
+                    count += (side0 != SIDE_NONE) + (side1 != SIDE_NONE);
+            }
+            chunkOffsets[c+1] = count;
+        }
+        for(size_t c = 0; c < nChunks; c++)
+            chunkOffsets[c+1] += chunkOffsets[c];
+
+        //Second pass: each chunk clips its pairs and writes its new vertexs in its own range
+        vertexs.resize(nVertexs + chunkOffsets[nChunks]);
+        std::vector<internal::BoxPoint>& boxPoints = buffers.boxPoints;
+        boxPoints.resize(chunkOffsets[nChunks] + 4);
+        #pragma omp parallel for num_threads(nThreads) if(nThreads > 1)
+        for(long long c = 0; c < nChunksSigned; c++) {
+            size_t end = std::min(nPairs, static_cast<size_t>(c + 1)*CLIPPING_CHUNK_SIZE), next = chunkOffsets[c];
+            for(size_t pair = static_cast<size_t>(c)*CLIPPING_CHUNK_SIZE; pair < end; pair++) {
+                size_t e = 2*pair, twin = dcel.getTwinID(e);
+                double px, py, dx, dy, t0, t1;
+                int side0, side1;
+                if(!internal::edgeLine(dcel, e, boundingBox, px, py, dx, dy, t0, t1) ||
+                        !internal::clipLine(px, py, dx, dy, boundingBox, t0, t1, side0, side1)) {
+                    edges[e].setOrigin(null);
+                    edges[e].setNext(null);
+                    edges[e].setPrev(null);
+                    edges[twin].setOrigin(null);
+                    edges[twin].setNext(null);
+                    edges[twin].setPrev(null);
+                    continue;
+                }
+
+                cg3::Point2Dd point;
+                if(side0 != SIDE_NONE) {
+                    boxPoints[next].s = internal::pointOnSide(px, py, dx, dy, t0, side0, boundingBox, point);
+                    boxPoints[next].vertex = nVertexs + next;
+                    boxPoints[next].arriving = twin;
+                    vertexs[nVertexs + next] = dcel.makeVertex(point, e);
+                    edges[e].setOrigin(nVertexs + next);
+                    next++;
+                }
+                if(side1 != SIDE_NONE) {
+                    boxPoints[next].s = internal::pointOnSide(px, py, dx, dy, t1, side1, boundingBox, point);
+                    boxPoints[next].vertex = nVertexs + next;
+                    boxPoints[next].arriving = e;
+                    vertexs[nVertexs + next] = dcel.makeVertex(point, twin);
+                    edges[twin].setOrigin(nVertexs + next);
+                    next++;
+                }
+            }
+        }
+
+        //The vertexs of the sweep outside the box are removed
+        #pragma omp parallel for num_threads(nThreads) if(nThreads > 1)
+        for(long long v = 0; v < static_cast<long long>(nVertexs); v++) {
+            if(!boundingBox.isInside(dcel.getVertexCoordinates(v)))
+                vertexs[v].setIncidEdge(null);
+        }
+
+        if(faces.empty())
+            return;
+
+        //Boundary of the box: the corners and the crossing vertexs sorted counterclockwise
+        size_t nCrossings = chunkOffsets[nChunks];
+        double width = boundingBox.max().x() - boundingBox.min().x(), height = boundingBox.max().y() - boundingBox.min().y();
+        const cg3::Point2Dd corners[4] = {boundingBox.min(), cg3::Point2Dd(boundingBox.max().x(), boundingBox.min().y()),
+                                          boundingBox.max(), cg3::Point2Dd(boundingBox.min().x(), boundingBox.max().y())};
+        const double cornersS[4] = {0, width, width + height, 2*width + height};
+        for(size_t i = 0; i < 4; i++) {
+            boxPoints[nCrossings + i].s = cornersS[i];
+            boxPoints[nCrossings + i].vertex = dcel.addVertex(dcel.makeVertex(corners[i]));
+            boxPoints[nCrossings + i].arriving = null;
+        }
+        std::sort(boxPoints.begin(), boxPoints.end());
+
+        //The walk starts from a crossing, whose arriving halfEdge gives the face of the following part of the boundary.
+        //Without crossings the box lies in a single cell, the one of the site nearest to its center
+        const size_t nBoxPoints = boxPoints.size();
+        size_t first = 0, face = null;
+        while(first < nBoxPoints && boxPoints[first].arriving == null)
+            first++;
+        if(first == nBoxPoints) {
+            first = 0;
+            cg3::Point2Dd center = (boundingBox.min() + boundingBox.max())/2;
+            double minDistance = std::numeric_limits<double>::max();
+            for(size_t f = 0; f < faces.size(); f++) {
+                double distance = faces[f].getSite().dist(center);
+                if(distance < minDistance) {
+                    minDistance = distance;
+                    face = f;
+                }
+            }
+        }
+
+        size_t firstInner = null, lastInner = null;
+        for(size_t k = 0; k < nBoxPoints; k++) {
+            const internal::BoxPoint& from = boxPoints[(first + k) % nBoxPoints];
+            const internal::BoxPoint& to = boxPoints[(first + k + 1) % nBoxPoints];
+            if(from.arriving != null)
+                face = edges[from.arriving].getFaceID();
+
+            size_t inner = dcel.addHalfEdgePair(face, null), outer = dcel.getTwinID(inner);
+            edges[inner].setOrigin(from.vertex);
+            edges[outer].setOrigin(to.vertex);
+            if(from.arriving == null)
+                vertexs[from.vertex].setIncidEdge(inner);
+
+            if(from.arriving != null) {
+                edges[from.arriving].setNext(inner);
+                edges[inner].setPrev(from.arriving);
+            } else if(lastInner != null) {
+                edges[lastInner].setNext(inner);
+                edges[inner].setPrev(lastInner);
+            }
+            if(to.arriving != null) {
+                size_t leaving = dcel.getTwinID(to.arriving);
+                edges[inner].setNext(leaving);
+                edges[leaving].setPrev(inner);
+            }
+            //The halfEdges outside the box form a single clockwise cycle
+            if(lastInner != null) {
+                edges[outer].setNext(dcel.getTwinID(lastInner));
+                edges[dcel.getTwinID(lastInner)].setPrev(outer);
+            }
+
+            if(firstInner == null)
+                firstInner = inner;
+            lastInner = inner;
+        }
+        edges[dcel.getTwinID(firstInner)].setNext(dcel.getTwinID(lastInner));
+        edges[dcel.getTwinID(lastInner)].setPrev(dcel.getTwinID(firstInner));
+        if(boxPoints[first].arriving == null) {
+            edges[lastInner].setNext(firstInner);
+            edges[firstInner].setPrev(lastInner);
+        }
+
+        //Each face gets one of its halfEdges that survived the clipping
+        for(size_t f = 0; f < faces.size(); f++)
+            faces[f].setIncidEdge(null);
+        for(size_t e = 0; e < edges.size(); e++) {
+            if(edges[e].getOriginID() != null && edges[e].getFaceID() != null)
+                faces[edges[e].getFaceID()].setIncidEdge(e);
+        }
+    }
+
+}
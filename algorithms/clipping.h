@@ -0,0 +1,43 @@
+#ifndef CLIPPING_H
+#define CLIPPING_H
+
+#include "../data_structures/dcel.h"
+#include <cg3/geometry/2d/bounding_box2d.h>
+
+namespace Voronoi {
+
+    namespace internal {
+
+        /**
+         * @brief The BoxPoint struct, a point on the boundary of the box: a vertex where a clipped edge crosses the box,
+         * or a corner of the box
+         */
+        struct BoxPoint {
+            //position along the boundary, counterclockwise from the min corner
+            double s;
+            size_t vertex;
+            //the halfEdge that reaches the vertex from the inside of the box, null for the corners
+            size_t arriving;
+
+            bool operator<(const BoxPoint& other) const {
+                return s < other.s || (s == other.s && vertex < other.vertex);
+            }
+        };
+
+    }
+
+    /**
+     * @brief The ClippingBuffers struct, the offsets of the chunks of halfEdges and the points on the boundary of the box
+     * used by clipDiagram. Reused for many diagrams, they allocate only for a larger diagram
+     */
+    struct ClippingBuffers {
+        std::vector<size_t> chunkOffsets;
+        std::vector<internal::BoxPoint> boxPoints;
+    };
+
+    void clipDiagram(DCEL& dcel, const cg3::BoundingBox2D& boundingBox);
+    void clipDiagram(DCEL& dcel, const cg3::BoundingBox2D& boundingBox, ClippingBuffers& buffers);
+
+}
+
+#endif // CLIPPING_H
@@ -0,0 +1,643 @@
+#include "delaunay.h"
+
+#include "cellrebuild.h"
+#include "clipping.h"
+#include "../mathVoronoi/predicates.h"
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+
+//Bits of each coordinate in the Hilbert index of the sites
+#define DELAUNAY_HILBERT_ORDER 16
+//Size under which the first rounds of the biased randomized insertion order are merged in a single one
+#define DELAUNAY_BRIO_FIRST_ROUND 64
+//Largest coordinate of the grid of exactDelaunayAlgorithm, 2^29-1: the terms of the exact in-circle determinant stay under 2^124
+#define EXACT_GRID_MAX 536870911
+
+namespace Voronoi {
+
+    namespace internal {
+
+        /**
+         * Predicates on the sites: the floating point ones are filtered and exact (exactOrientation, exactInCircle)
+         */
+        inline int orientationSign(const cg3::Point2Dd& a, const cg3::Point2Dd& b, const cg3::Point2Dd& c) {
+            return exactOrientation(a, b, c);
+        }
+
+        inline int inCircleSign(const cg3::Point2Dd& a, const cg3::Point2Dd& b, const cg3::Point2Dd& c, const cg3::Point2Dd& d) {
+            return exactInCircle(a, b, c, d);
+        }
+
+        /**
+         * @brief isInsideSegment true if p, on the line through a and b, is strictly between them
+         */
+        template<class Point>
+        inline bool isInsideSegment(const Point& a, const Point& b, const Point& p) {
+            if(a.x() != b.x())
+                return (a.x() < p.x() && p.x() < b.x()) || (b.x() < p.x() && p.x() < a.x());
+            return (a.y() < p.y() && p.y() < b.y()) || (b.y() < p.y() && p.y() < a.y());
+        }
+
+        /**
+         * Exact predicates on the integer grid: the coordinates are in [-EXACT_GRID_MAX, EXACT_GRID_MAX],
+         * so the orientation fits in 64 bits and the terms of the in-circle determinant in 128 bits
+         */
+        #ifdef __SIZEOF_INT128__
+        typedef __int128 ExactProduct;
+
+        inline ExactProduct exactProduct(long long a, long long b) {
+            return static_cast<ExactProduct>(a)*b;
+        }
+
+        inline int exactSign(const ExactProduct& x) {
+            return (x > 0) - (x < 0);
+        }
+        #else
+        /**
+         * @brief The ExactProduct struct, a 128-bit two's complement integer, for the compilers without a native one
+         */
+        struct ExactProduct {
+            unsigned long long low;
+            long long high;
+
+            ExactProduct operator+(const ExactProduct& other) const {
+                ExactProduct sum;
+                sum.low = low + other.low;
+                sum.high = high + other.high + (sum.low < low);
+                return sum;
+            }
+
+            ExactProduct operator-(const ExactProduct& other) const {
+                ExactProduct opposite;
+                opposite.low = ~other.low + 1;
+                opposite.high = ~other.high + (opposite.low == 0);
+                return *this + opposite;
+            }
+        };
+
+        inline ExactProduct exactProduct(long long a, long long b) {
+            bool negative = (a < 0) != (b < 0);
+            unsigned long long ua = a < 0 ? 0ULL - static_cast<unsigned long long>(a) : static_cast<unsigned long long>(a);
+            unsigned long long ub = b < 0 ? 0ULL - static_cast<unsigned long long>(b) : static_cast<unsigned long long>(b);
+            unsigned long long a0 = ua & 0xFFFFFFFFULL, a1 = ua >> 32, b0 = ub & 0xFFFFFFFFULL, b1 = ub >> 32;
+            unsigned long long p00 = a0*b0, p01 = a0*b1, p10 = a1*b0, p11 = a1*b1;
+            unsigned long long middle = (p00 >> 32) + (p01 & 0xFFFFFFFFULL) + (p10 & 0xFFFFFFFFULL);
+            ExactProduct product;
+            product.low = (middle << 32) | (p00 & 0xFFFFFFFFULL);
+            product.high = static_cast<long long>(p11 + (p01 >> 32) + (p10 >> 32) + (middle >> 32));
+            if(negative) {
+                product.low = ~product.low + 1;
+                product.high = ~product.high + (product.low == 0);
+            }
+            return product;
+        }
+
+        inline int exactSign(const ExactProduct& x) {
+            return x.high < 0 ? -1 : (x.high > 0 || x.low > 0);
+        }
+        #endif
+
+        inline int orientationSign(const cg3::Point2Di& a, const cg3::Point2Di& b, const cg3::Point2Di& c) {
+            long long o = static_cast<long long>(b.x() - a.x())*(c.y() - a.y()) - static_cast<long long>(b.y() - a.y())*(c.x() - a.x());
+            return (o > 0) - (o < 0);
+        }
+
+        inline int inCircleSign(const cg3::Point2Di& a, const cg3::Point2Di& b, const cg3::Point2Di& c, const cg3::Point2Di& d) {
+            long long ax = a.x() - d.x(), ay = a.y() - d.y();
+            long long bx = b.x() - d.x(), by = b.y() - d.y();
+            long long cx = c.x() - d.x(), cy = c.y() - d.y();
+            return exactSign(exactProduct(ax*ax + ay*ay, bx*cy - cx*by) - exactProduct(bx*bx + by*by, ax*cy - cx*ay) +
+                             exactProduct(cx*cx + cy*cy, ax*by - bx*ay));
+        }
+
+        /**
+         * @brief hilbertIndex the position of the cell (x, y) along the Hilbert curve of the grid
+         */
+        uint64_t hilbertIndex(uint32_t x, uint32_t y) {
+            const uint32_t n = 1u << DELAUNAY_HILBERT_ORDER;
+            uint64_t d = 0;
+            for(uint32_t s = n/2; s > 0; s /= 2) {
+                uint32_t rx = (x & s) > 0, ry = (y & s) > 0;
+                d += static_cast<uint64_t>(s)*s*((3*rx) ^ ry);
+                if(ry == 0) {
+                    if(rx == 1) {
+                        x = n - 1 - x;
+                        y = n - 1 - y;
+                    }
+                    std::swap(x, y);
+                }
+            }
+            return d;
+        }
+
+        /**
+         * @brief brioOrder the biased randomized insertion order of the sites: they are shuffled and split in rounds,
+         * each one twice the previous, and the sites of each round are sorted along the Hilbert curve.
+         * Consecutive sites are near, while the rounds keep the expected cost of the randomized insertion
+         */
+        void brioOrder(const std::vector<cg3::Point2Dd>& points, std::vector<size_t>& order) {
+            const size_t n = points.size();
+            order.resize(n);
+            for(size_t i = 0; i < n; i++)
+                order[i] = i;
+            if(n == 0)
+                return;
+
+            std::mt19937_64 generator(0);
+            std::shuffle(order.begin(), order.end(), generator);
+
+            double minX = points[0].x(), minY = points[0].y(), maxX = minX, maxY = minY;
+            for(const cg3::Point2Dd& p : points) {
+                minX = std::min(minX, p.x());
+                maxX = std::max(maxX, p.x());
+                minY = std::min(minY, p.y());
+                maxY = std::max(maxY, p.y());
+            }
+            const double cells = (1u << DELAUNAY_HILBERT_ORDER) - 1;
+            double scale = std::max(maxX - minX, maxY - minY);
+            scale = scale > 0 ? cells/scale : 0;
+            std::vector<uint64_t> keys(n);
+            for(size_t i = 0; i < n; i++)
+                keys[i] = hilbertIndex(static_cast<uint32_t>((points[i].x() - minX)*scale),
+                                       static_cast<uint32_t>((points[i].y() - minY)*scale));
+
+            auto byKey = [&keys](size_t a, size_t b) {
+                return keys[a] < keys[b];
+            };
+            size_t end = n;
+            while(end > DELAUNAY_BRIO_FIRST_ROUND) {
+                size_t begin = end/2;
+                std::sort(order.begin() + begin, order.begin() + end, byKey);
+                end = begin;
+            }
+            std::sort(order.begin(), order.begin() + end, byKey);
+        }
+
+        /**
+         * @brief The Triangle struct, a counterclockwise triangle of the triangulation.
+         * The triangles outside the convex hull have the infinite vertex (the null index) in place of a site:
+         * each one is bounded by an edge of the hull. The removed triangles have three null vertexs
+         */
+        struct Triangle {
+            size_t v[3];
+            size_t n[3]; //n[i] is the triangle on the other side of the edge opposite to v[i]
+        };
+
+        /**
+         * @brief The DelaunayTriangulation class, a Delaunay triangulation built inserting one site at a time (Bowyer-Watson).
+         * A site is located walking from the last triangle created, the triangles whose circle contains it are removed
+         * and their boundary is connected to the site. Point is cg3::Point2Dd for the floating point predicates,
+         * or cg3::Point2Di for the exact ones on the integer grid
+         */
+        template<class Point>
+        class DelaunayTriangulation {
+        public:
+            DelaunayTriangulation(const std::vector<Point>& points);
+
+            bool initialize(const std::vector<size_t>& order, size_t& first, size_t& second, size_t& third);
+            bool insert(size_t site);
+            const std::vector<Triangle>& getTriangles() const;
+            void cocircularGroups(std::vector<size_t>& groups) const;
+
+        private:
+            int infiniteIndex(const Triangle& t) const;
+            bool isInConflict(size_t t, const Point& p) const;
+            size_t locate(size_t site) const;
+            size_t addTriangle(const Triangle& t);
+
+            struct BoundaryEdge {
+                size_t from, to, outside;
+                int outsideIndex; //the index of the edge in the triangle outside the cavity
+            };
+
+            const std::vector<Point>& points;
+            std::vector<Triangle> triangles;
+            std::vector<size_t> freeTriangles;
+            std::vector<unsigned int> marks;
+            unsigned int mark;
+            size_t last;
+
+            std::vector<size_t> cavity, newTriangles, boundaryStart;
+            std::vector<BoundaryEdge> boundary;
+        };
+
+        template<class Point>
+        DelaunayTriangulation<Point>::DelaunayTriangulation(const std::vector<Point>& points) :
+            points(points), mark(0), last(0), boundaryStart(points.size() + 1) {
+            triangles.reserve(2*points.size() + 4);
+            marks.reserve(2*points.size() + 4);
+        }
+
+        /**
+         * @brief initialize creates the first triangle with the first three sites of order not on a line,
+         * and the three triangles outside its edges
+         * @return false if all the sites are on a line
+         */
+        template<class Point>
+        bool DelaunayTriangulation<Point>::initialize(const std::vector<size_t>& order, size_t& first, size_t& second, size_t& third) {
+            const size_t null = std::numeric_limits<size_t>::max();
+            if(order.empty())
+                return false;
+            first = order[0];
+            second = third = null;
+            for(size_t i = 1; i < order.size() && third == null; i++) {
+                if(second == null) {
+                    if(points[order[i]] != points[first])
+                        second = order[i];
+                } else if(orientationSign(points[first], points[second], points[order[i]]) != 0)
+                    third = order[i];
+            }
+            if(third == null)
+                return false;
+            size_t a = first, b = second, c = third;
+            if(orientationSign(points[a], points[b], points[c]) < 0)
+                std::swap(b, c);
+
+            Triangle inner = {{a, b, c}, {1, 2, 3}};
+            Triangle outerA = {{c, b, null}, {3, 2, 0}};
+            Triangle outerB = {{a, c, null}, {1, 3, 0}};
+            Triangle outerC = {{b, a, null}, {2, 1, 0}};
+            addTriangle(inner);
+            addTriangle(outerA);
+            addTriangle(outerB);
+            addTriangle(outerC);
+            return true;
+        }
+
+        /**
+         * @brief insert adds the site to the triangulation
+         * @return false if the site is equal to a site already in the triangulation, which is left untouched
+         */
+        template<class Point>
+        bool DelaunayTriangulation<Point>::insert(size_t site) {
+            const size_t null = std::numeric_limits<size_t>::max();
+            const Point& p = points[site];
+            size_t start = locate(site);
+            if(start == null)
+                return false;
+
+            //Cavity: the triangles in conflict with the site, connected to the one containing it
+            mark++;
+            cavity.clear();
+            boundary.clear();
+            cavity.push_back(start);
+            marks[start] = mark;
+            for(size_t c = 0; c < cavity.size(); c++) {
+                const Triangle& t = triangles[cavity[c]];
+                for(int i = 0; i < 3; i++) {
+                    size_t other = t.n[i];
+                    if(marks[other] == mark)
+                        continue;
+                    if(isInConflict(other, p)) {
+                        marks[other] = mark;
+                        cavity.push_back(other);
+                    } else {
+                        const Triangle& outside = triangles[other];
+                        int j = outside.n[0] == cavity[c] ? 0 : outside.n[1] == cavity[c] ? 1 : 2;
+                        BoundaryEdge edge = {t.v[(i+1) % 3], t.v[(i+2) % 3], other, j};
+                        boundary.push_back(edge);
+                    }
+                }
+            }
+            for(size_t t : cavity) {
+                Triangle& triangle = triangles[t];
+                triangle.v[0] = triangle.v[1] = triangle.v[2] = null;
+                freeTriangles.push_back(t);
+            }
+
+            //A new triangle for each edge of the boundary of the cavity, with the site as third vertex
+            const size_t infinite = points.size();
+            newTriangles.resize(boundary.size());
+            for(size_t k = 0; k < boundary.size(); k++) {
+                const BoundaryEdge& edge = boundary[k];
+                Triangle t = {{edge.from, edge.to, site}, {null, null, edge.outside}};
+                size_t id = addTriangle(t);
+                triangles[edge.outside].n[edge.outsideIndex] = id;
+                newTriangles[k] = id;
+                boundaryStart[edge.from != null ? edge.from : infinite] = k;
+            }
+            for(size_t k = 0; k < boundary.size(); k++) {
+                size_t to = boundary[k].to != null ? boundary[k].to : infinite;
+                size_t next = newTriangles[boundaryStart[to]];
+                triangles[newTriangles[k]].n[0] = next;
+                triangles[next].n[1] = newTriangles[k];
+            }
+            last = newTriangles[0];
+            return true;
+        }
+
+        template<class Point>
+        inline const std::vector<Triangle>& DelaunayTriangulation<Point>::getTriangles() const {
+            return triangles;
+        }
+
+        /**
+         * @brief infiniteIndex the position of the infinite vertex in t, -1 if t is inside the convex hull
+         */
+        /**
+         * @brief cocircularGroups groups[t] is the same for the triangles linked by edges whose two triangles share their circle:
+         * their centers are a single vertex of the diagram, and the edges between them have no dual
+         */
+        template<class Point>
+        void DelaunayTriangulation<Point>::cocircularGroups(std::vector<size_t>& groups) const {
+            const size_t null = std::numeric_limits<size_t>::max();
+            groups.resize(triangles.size());
+            for(size_t t = 0; t < triangles.size(); t++)
+                groups[t] = t;
+            auto find = [&groups](size_t t) {
+                while(groups[t] != t)
+                    t = groups[t] = groups[groups[t]];
+                return t;
+            };
+
+            for(size_t t = 0; t < triangles.size(); t++) {
+                const Triangle& triangle = triangles[t];
+                if(triangle.v[0] == null || triangle.v[1] == null || triangle.v[2] == null)
+                    continue;
+                for(int i = 0; i < 3; i++) {
+                    size_t other = triangle.n[i];
+                    if(other < t)
+                        continue;
+                    const Triangle& neighbour = triangles[other];
+                    int j = neighbour.n[0] == t ? 0 : neighbour.n[1] == t ? 1 : 2;
+                    if(neighbour.v[j] != null && neighbour.v[(j+1) % 3] != null && neighbour.v[(j+2) % 3] != null &&
+                       inCircleSign(points[triangle.v[0]], points[triangle.v[1]], points[triangle.v[2]], points[neighbour.v[j]]) == 0)
+                        groups[find(other)] = find(t);
+                }
+            }
+            for(size_t t = 0; t < triangles.size(); t++)
+                groups[t] = find(t);
+        }
+
+        template<class Point>
+        inline int DelaunayTriangulation<Point>::infiniteIndex(const Triangle& t) const {
+            for(int i = 0; i < 3; i++) {
+                if(t.v[i] == std::numeric_limits<size_t>::max())
+                    return i;
+            }
+            return -1;
+        }
+
+        /**
+         * @brief isInConflict true if p is inside the circle of the triangle t.
+         * The circle of a triangle outside the hull is the open half-plane beyond its edge, with the inside of the edge
+         */
+        template<class Point>
+        bool DelaunayTriangulation<Point>::isInConflict(size_t t, const Point& p) const {
+            const Triangle& triangle = triangles[t];
+            int k = infiniteIndex(triangle);
+            if(k < 0)
+                return inCircleSign(points[triangle.v[0]], points[triangle.v[1]], points[triangle.v[2]], p) > 0;
+
+            const Point& a = points[triangle.v[(k+1) % 3]];
+            const Point& b = points[triangle.v[(k+2) % 3]];
+            int o = orientationSign(a, b, p);
+            return o != 0 ? o > 0 : isInsideSegment(a, b, p);
+        }
+
+        /**
+         * @brief locate a triangle in conflict with the site: the one containing it, or the one outside the hull
+         * where the walk from the last triangle created leaves the hull
+         * @return null if the site is equal to a site of the triangulation
+         */
+        template<class Point>
+        size_t DelaunayTriangulation<Point>::locate(size_t site) const {
+            const size_t null = std::numeric_limits<size_t>::max();
+            const Point& p = points[site];
+            size_t t = last;
+            int k = infiniteIndex(triangles[t]);
+            if(k >= 0)
+                t = triangles[t].n[k];
+
+            //Walk towards the site, starting each time from a different edge so the walk cannot cycle
+            for(size_t steps = 0; ; steps++) {
+                const Triangle& triangle = triangles[t];
+                if(infiniteIndex(triangle) >= 0)
+                    return t;
+                size_t next = null;
+                for(int j = 0; j < 3 && next == null; j++) {
+                    int i = static_cast<int>((j + steps) % 3);
+                    if(orientationSign(points[triangle.v[(i+1) % 3]], points[triangle.v[(i+2) % 3]], p) < 0)
+                        next = triangle.n[i];
+                }
+                if(next == null) {
+                    for(int i = 0; i < 3; i++) {
+                        if(points[triangle.v[i]] == p)
+                            return null;
+                    }
+                    return t;
+                }
+                t = next;
+            }
+        }
+
+        /**
+         * @brief addTriangle stores the triangle in the slot of a removed one, if any
+         */
+        template<class Point>
+        size_t DelaunayTriangulation<Point>::addTriangle(const Triangle& t) {
+            size_t id;
+            if(!freeTriangles.empty()) {
+                id = freeTriangles.back();
+                freeTriangles.pop_back();
+                triangles[id] = t;
+            } else {
+                id = triangles.size();
+                triangles.push_back(t);
+                marks.push_back(0);
+            }
+            return id;
+        }
+
+        /**
+         * @brief triangulationDiagram adds the diagram of the triangulation to dcel unclipped, as the sweep leaves it:
+         * a vertex at the center of each group of cocircular triangles (groups), a pair of halfEdges for each edge of the triangulation
+         * between two groups, and a halfEdge without origin towards the infinite vertex for the edges of the hull (rays).
+         * The sites are visited in order, so near cells are built one after the other, and the halfEdges of each cell are linked
+         * counterclockwise up to the rays, which are closed by clipDiagram. The vertexs and halfEdges are shared through
+         * the triangles, so the two cells of an edge always agree on it, whatever the position of its vertexs
+         */
+        void triangulationDiagram(const std::vector<Triangle>& triangles, const std::vector<size_t>& groups, const std::vector<size_t>& order,
+                                  const std::vector<bool>& inserted, size_t firstFace, DCEL& dcel, const cg3::BoundingBox2D& box) {
+            const size_t null = std::numeric_limits<size_t>::max();
+            std::vector<HalfEdge>& edges = dcel.getHalfEdges();
+            const std::vector<Face>& faces = dcel.getFaces();
+
+            std::vector<size_t> siteTriangles(inserted.size(), null);
+            for(size_t t = 0; t < triangles.size(); t++) {
+                for(int i = 0; i < 3; i++) {
+                    if(triangles[t].v[i] != null)
+                        siteTriangles[triangles[t].v[i]] = t;
+                }
+            }
+            std::vector<size_t> triangleVertexs(triangles.size(), null), triangleEdges(3*triangles.size(), null);
+
+            //the center of the group of t, with the site at v[k], null outside the hull
+            auto center = [&](size_t t, int k) {
+                const Triangle& triangle = triangles[t];
+                size_t a = triangle.v[(k+1) % 3], b = triangle.v[(k+2) % 3];
+                if(a == null || b == null)
+                    return null;
+                size_t& vertex = triangleVertexs[groups[t]];
+                if(vertex == null)
+                    vertex = dcel.addVertex(dcel.makeVertex(vertexPosition(vertexKey(firstFace + triangle.v[k], firstFace + a, firstFace + b), faces, box)));
+                return vertex;
+            };
+
+            std::vector<size_t> cellEdges;
+            for(size_t site : order) {
+                if(!inserted[site])
+                    continue;
+                const size_t face = firstFace + site;
+
+                //The triangles around the site, counterclockwise: the edge from the center of a triangle to the center
+                //of the next one is the one towards their common neighbour, none between two triangles of a group
+                cellEdges.clear();
+                size_t start = siteTriangles[site], t = start;
+                do {
+                    const Triangle& triangle = triangles[t];
+                    int k = triangle.v[0] == site ? 0 : triangle.v[1] == site ? 1 : 2;
+                    size_t next = triangle.n[(k+1) % 3];
+                    const Triangle& nextTriangle = triangles[next];
+                    int nextK = nextTriangle.v[0] == site ? 0 : nextTriangle.v[1] == site ? 1 : 2;
+                    size_t neighbour = triangle.v[(k+2) % 3], from = center(t, k), to = center(next, nextK);
+                    if(neighbour != null && (from == null || to == null || groups[t] != groups[next])) {
+                        //the slot of the halfEdge of the cell of the site in next, and the slot of its twin in t
+                        size_t slot = 3*next + (nextK+2) % 3, twinSlot = 3*t + (k+1) % 3;
+                        if(triangleEdges[slot] == null) {
+                            size_t e = dcel.addHalfEdgePair(face, firstFace + neighbour);
+                            edges[e].setOrigin(from);
+                            edges[e+1].setOrigin(to);
+                            if(from != null)
+                                dcel.getVertexs()[from].setIncidEdge(e);
+                            if(to != null)
+                                dcel.getVertexs()[to].setIncidEdge(e+1);
+                            triangleEdges[slot] = e;
+                            triangleEdges[twinSlot] = e+1;
+                        }
+                        cellEdges.push_back(triangleEdges[slot]);
+                    }
+                    t = next;
+                } while(t != start);
+
+                const size_t m = cellEdges.size();
+                for(size_t j = 0; j < m; j++) {
+                    size_t e = cellEdges[j], next = cellEdges[(j+1) % m];
+                    if(edges[dcel.getTwinID(e)].getOriginID() != null) {
+                        edges[e].setNext(next);
+                        edges[next].setPrev(e);
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief lineDiagram adds the diagram of sites all on a line: the bisectors of the consecutive distinct sites
+         * along the line, as pairs of halfEdges without origin, closed by clipDiagram
+         */
+        void lineDiagram(const std::vector<cg3::Point2Dd>& points, const std::vector<size_t>& order,
+                         std::vector<bool>& inserted, size_t firstFace, DCEL& dcel) {
+            std::vector<size_t> line(order);
+            std::sort(line.begin(), line.end(), [&points](size_t a, size_t b) {
+                return points[a].x() < points[b].x() || (points[a].x() == points[b].x() && points[a].y() < points[b].y());
+            });
+            line.erase(std::unique(line.begin(), line.end(), [&points](size_t a, size_t b) {
+                return points[a] == points[b];
+            }), line.end());
+
+            for(size_t i = 0; i < line.size(); i++) {
+                inserted[line[i]] = true;
+                if(i > 0)
+                    dcel.addHalfEdgePair(firstFace + line[i-1], firstFace + line[i]);
+            }
+        }
+
+        /**
+         * @brief delaunayDiagram adds to dcel a face for each site and the diagram of the Delaunay triangulation of the sites,
+         * clipped by clipDiagram as the one of the sweep. The predicates are evaluated on grid, the sites in the coordinates of Point
+         * (the sites themselves for the floating point predicates)
+         */
+        template<class Point>
+        void delaunayDiagram(const std::vector<Point>& grid, const std::vector<cg3::Point2Dd>& sites, DCEL& dcel,
+                             const cg3::BoundingBox2D& boundingBox) {
+            const size_t n = sites.size();
+
+            //A face for each site, in the same order of points
+            dcel.fitOrigin(boundingBox);
+            size_t firstFace = dcel.getFaces().size();
+            dcel.getFaces().reserve(firstFace + n);
+            for(const cg3::Point2Dd& p : sites)
+                dcel.addFace(Face(p));
+            dcel.getHalfEdges().reserve(dcel.getHalfEdges().size() + 6*n);
+            dcel.getVertexs().reserve(dcel.getVertexs().size() + 2*n);
+
+            std::vector<size_t> order;
+            brioOrder(sites, order);
+
+            std::vector<bool> inserted(n, false);
+            DelaunayTriangulation<Point> triangulation(grid);
+            size_t first, second, third;
+            if(triangulation.initialize(order, first, second, third)) {
+                inserted[first] = inserted[second] = inserted[third] = true;
+                for(size_t site : order) {
+                    if(!inserted[site])
+                        inserted[site] = triangulation.insert(site);
+                }
+                std::vector<size_t> groups;
+                triangulation.cocircularGroups(groups);
+                triangulationDiagram(triangulation.getTriangles(), groups, order, inserted, firstFace, dcel, boundingBox);
+            } else if(n > 0)
+                lineDiagram(sites, order, inserted, firstFace, dcel);
+            clipDiagram(dcel, boundingBox);
+        }
+
+    }
+
+    /**
+     * @brief delaunayAlgorithm computes the same diagram of fortuneAlgorithm as the dual of the Delaunay triangulation of the sites,
+     * built inserting them in biased randomized order. Sites equal to a previous one get a face without a cell
+     * @param points: the sites of the diagram
+     * @param dcel: the DCEL where the diagram is stored
+     * @param boundingBox: the box used to clip the diagram, the cells are closed by its boundary
+     */
+    void delaunayAlgorithm(const std::vector<cg3::Point2Dd>& points, DCEL& dcel,
+                           const cg3::BoundingBox2D& boundingBox) {
+        internal::delaunayDiagram(points, points, dcel, boundingBox);
+    }
+
+    /**
+     * @brief exactDelaunayAlgorithm computes the diagram as delaunayAlgorithm, snapping the sites to an integer grid
+     * of 2*EXACT_GRID_MAX+1 values per side over the box and the sites: orientation and in-circle are evaluated exactly
+     * on the grid, in 64 and 128 bit integers, so the triangulation is the Delaunay one of the snapped sites,
+     * whatever their position (cocircular, collinear or nearly so). Its dual is computed in double and clipped once per edge,
+     * so the diagram keeps the topology of the triangulation. The faces get the snapped sites,
+     * sites snapped to the same point of the grid are duplicates and get a face without a cell
+     * @param points: the sites of the diagram
+     * @param dcel: the DCEL where the diagram is stored
+     * @param boundingBox: the box used to clip the diagram, the cells are closed by its boundary
+     */
+    void exactDelaunayAlgorithm(const std::vector<cg3::Point2Dd>& points, DCEL& dcel,
+                                const cg3::BoundingBox2D& boundingBox) {
+        //The grid is centered on the box containing the bounding box and the sites, its side fits 2*EXACT_GRID_MAX steps
+        cg3::Point2Dd min = boundingBox.min(), max = boundingBox.max();
+        for(const cg3::Point2Dd& p : points) {
+            min = cg3::Point2Dd(std::min(min.x(), p.x()), std::min(min.y(), p.y()));
+            max = cg3::Point2Dd(std::max(max.x(), p.x()), std::max(max.y(), p.y()));
+        }
+        const cg3::Point2Dd center((min.x() + max.x())/2, (min.y() + max.y())/2);
+        const double halfSide = std::max(max.x() - min.x(), max.y() - min.y())/2;
+        const double scale = halfSide > 0 ? EXACT_GRID_MAX/halfSide : 1;
+
+        std::vector<cg3::Point2Di> grid(points.size());
+        std::vector<cg3::Point2Dd> snapped(points.size());
+        for(size_t i = 0; i < points.size(); i++) {
+            grid[i] = cg3::Point2Di(static_cast<int>(std::lround((points[i].x() - center.x())*scale)),
+                                    static_cast<int>(std::lround((points[i].y() - center.y())*scale)));
+            snapped[i] = cg3::Point2Dd(center.x() + grid[i].x()/scale, center.y() + grid[i].y()/scale);
+        }
+        internal::delaunayDiagram(grid, snapped, dcel, boundingBox);
+    }
+
+}
@@ -0,0 +1,16 @@
+#ifndef DELAUNAY_H
+#define DELAUNAY_H
+
+#include "../data_structures/dcel.h"
+#include <cg3/geometry/2d/bounding_box2d.h>
+
+namespace Voronoi {
+
+    void delaunayAlgorithm(const std::vector<cg3::Point2Dd>& points, DCEL& dcel,
+                           const cg3::BoundingBox2D& boundingBox);
+    void exactDelaunayAlgorithm(const std::vector<cg3::Point2Dd>& points, DCEL& dcel,
+                                const cg3::BoundingBox2D& boundingBox);
+
+}
+
+#endif // DELAUNAY_H
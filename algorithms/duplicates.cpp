@@ -0,0 +1,83 @@
+#include "duplicates.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Voronoi {
+
+    /**
+     * @brief collapseDuplicateSites finds the sites equal to a previous one, sorting them with sortSitesByX, and keeps
+     * only the first of each group. With a tolerance the sites are compared by the cell of the grid of side tolerance
+     * (with a corner at the origin) that contains them, so sites nearer than the tolerance are usually merged,
+     * but two sites on the two sides of a line of the grid are not
+     * @param points: the sites, possibly with duplicates
+     * @param uniqueSites: output, the coordinates x0 y0 x1 y1 ... of the first site of each group,
+     * in the order of their first occurrence, so without duplicates they are the sites in the input order
+     * @param aliases: output, aliases[i] is the index in uniqueSites of the group of the site i
+     * @param tolerance: 0 to merge only the equal sites
+     */
+    void collapseDuplicateSites(const SiteSpan& points, std::vector<double>& uniqueSites, std::vector<size_t>& aliases,
+                                double tolerance) {
+        const size_t n = points.size();
+        //The keys are the coordinates, or the cells of the grid with a tolerance.
+        //Adding 0.0 turns -0.0 into +0.0, so the two zeros are the same key for the sort and for the comparisons
+        std::vector<double> cells(2*n);
+        for(size_t i = 0; i < n; i++) {
+            cells[2*i] = (tolerance > 0 ? std::floor(points.x(i)/tolerance) : points.x(i)) + 0.0;
+            cells[2*i+1] = (tolerance > 0 ? std::floor(points.y(i)/tolerance) : points.y(i)) + 0.0;
+        }
+        const SiteSpan keys(cells.data(), n);
+        std::vector<size_t> order;
+        sortSitesByX(keys, order);
+
+        //The equal keys are adjacent in order: each site gets the first site of its run
+        aliases.resize(n);
+        size_t begin = 0;
+        while(begin < n) {
+            size_t end = begin + 1, first = order[begin];
+            while(end < n && keys.x(order[end]) == keys.x(order[begin]) && keys.y(order[end]) == keys.y(order[begin])) {
+                first = std::min(first, order[end]);
+                end++;
+            }
+            for(size_t k = begin; k < end; k++)
+                aliases[order[k]] = first;
+            begin = end;
+        }
+
+        //The first site of a group comes before the others, so its alias is already its index in uniqueSites
+        uniqueSites.clear();
+        for(size_t i = 0; i < n; i++) {
+            if(aliases[i] == i) {
+                aliases[i] = uniqueSites.size()/2;
+                uniqueSites.push_back(points.x(i));
+                uniqueSites.push_back(points.y(i));
+            } else
+                aliases[i] = aliases[aliases[i]];
+        }
+    }
+
+    /**
+     * @brief computeUniqueVoronoiDiagram computes the diagram of points as computeVoronoiDiagram with the Fortune's engine,
+     * after collapsing the duplicate sites, so that each group of equal sites gets one face instead of a face
+     * with a cell and empty faces for the others
+     * @param points: the sites, possibly with duplicates
+     * @param dcel: the DCEL where the diagram is stored, it has a face for each group of equal sites
+     * @param boundingBox: the box used to clip the diagram, the cells are closed by its boundary
+     * @param aliases: output, aliases[i] is the face of the cell of the site i
+     * @param tolerance: 0 to merge only the equal sites, otherwise the size of the grid of collapseDuplicateSites
+     */
+    void computeUniqueVoronoiDiagram(const SiteSpan& points, DCEL& dcel, const cg3::BoundingBox2D& boundingBox,
+                                     std::vector<size_t>& aliases, double tolerance) {
+        std::vector<double> uniqueSites;
+        collapseDuplicateSites(points, uniqueSites, aliases, tolerance);
+
+        const size_t firstFace = dcel.getFaces().size();
+        SweepWorkspace workspace;
+        computeVoronoiDiagram(SiteSpan(uniqueSites.data(), uniqueSites.size()/2), dcel, boundingBox, workspace);
+        if(firstFace > 0) {
+            for(size_t& alias : aliases)
+                alias += firstFace;
+        }
+    }
+
+}
@@ -0,0 +1,15 @@
+#ifndef DUPLICATES_H
+#define DUPLICATES_H
+
+#include "voronoidiagram.h"
+
+namespace Voronoi {
+
+    void collapseDuplicateSites(const SiteSpan& points, std::vector<double>& uniqueSites, std::vector<size_t>& aliases,
+                                double tolerance = 0);
+    void computeUniqueVoronoiDiagram(const SiteSpan& points, DCEL& dcel, const cg3::BoundingBox2D& boundingBox,
+                                     std::vector<size_t>& aliases, double tolerance = 0);
+
+}
+
+#endif // DUPLICATES_H
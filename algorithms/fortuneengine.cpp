@@ -0,0 +1,41 @@
+#include "fortuneengine.h"
+
+namespace Voronoi {
+
+    /**
+     * @brief FortuneEngine::reserve allocates the workspace and the DCEL for diagrams of nSites sites
+     * @param nSites
+     */
+    void FortuneEngine::reserve(size_t nSites) {
+        workspace.reserve(nSites);
+        diagram.getFaces().reserve(nSites);
+        //a diagram of n sites has at most 3n - 6 edges and 2n - 5 vertexs, plus the ones on the boundary of the box
+        diagram.getHalfEdges().reserve(6*nSites + 8);
+        diagram.getVertexs().reserve(2*nSites + 4);
+    }
+
+    /**
+     * @brief FortuneEngine::compute computes the Voronoi diagram of points in the DCEL of the engine,
+     * as computeVoronoiDiagram with the Fortune's engine
+     * @param points: the sites of the diagram
+     * @param boundingBox: the box used to clip the diagram, the cells are closed by its boundary
+     * @return the DCEL of the engine, valid until the next call of compute
+     */
+    const DCEL& FortuneEngine::compute(const SiteSpan& points, const cg3::BoundingBox2D& boundingBox) {
+        compute(points, diagram, boundingBox);
+        return diagram;
+    }
+
+    /**
+     * @brief FortuneEngine::compute computes the Voronoi diagram of points in dcel with the workspace of the engine.
+     * The previous content of dcel is cleared, its memory is reused
+     * @param points: the sites of the diagram
+     * @param dcel: the DCEL where the diagram is stored, it can be a plain DCEL or any class derived from it
+     * @param boundingBox: the box used to clip the diagram, the cells are closed by its boundary
+     */
+    void FortuneEngine::compute(const SiteSpan& points, DCEL& dcel, const cg3::BoundingBox2D& boundingBox) {
+        dcel.clear();
+        computeVoronoiDiagram(points, dcel, boundingBox, workspace);
+    }
+
+}
@@ -0,0 +1,40 @@
+#ifndef FORTUNEENGINE_H
+#define FORTUNEENGINE_H
+
+#include "voronoidiagram.h"
+
+namespace Voronoi {
+    /**
+     * @class FortuneEngine
+     * @brief The FortuneEngine class, a context for computing many diagrams one after the other.
+     * It owns the workspace of the sweep (beachline nodes, circle events, order of the sites, buffers of the sort
+     * and of the clipping) and a DCEL, and keeps their memory between the calls of compute: once they have grown
+     * to the size of the inputs, computing another diagram of at most the same size doesn't allocate, also for degenerate
+     * sites (the exact predicates keep their expansions on the stack)
+     */
+    class FortuneEngine {
+        public:
+            FortuneEngine() = default;
+            FortuneEngine(const FortuneEngine&) = delete;
+            FortuneEngine& operator=(const FortuneEngine&) = delete;
+
+            void reserve(size_t nSites);
+            const DCEL& compute(const SiteSpan& points, const cg3::BoundingBox2D& boundingBox);
+            void compute(const SiteSpan& points, DCEL& dcel, const cg3::BoundingBox2D& boundingBox);
+
+            const DCEL& getDCEL() const;
+        private:
+            SweepWorkspace workspace;
+            DCEL diagram;
+    };
+
+    /**
+     * @brief FortuneEngine::getDCEL
+     * @return the diagram of the last call of compute without a DCEL
+     */
+    inline const DCEL& FortuneEngine::getDCEL() const {
+        return diagram;
+    }
+}
+
+#endif // FORTUNEENGINE_H
@@ -0,0 +1,338 @@
+#include "halfplane.h"
+
+#include "cellrebuild.h"
+#include "voronoidiagram.h"
+#include "../mathVoronoi/predicates.h"
+
+#include <cmath>
+
+//Largest number of sites of halfPlaneAlgorithm, its buffers are on the stack
+#define HALF_PLANE_CAPACITY 64
+//Number of nearest sites clipping a cell before the others, about the number of edges of a cell
+#define HALF_PLANE_NEAREST 4
+//Relative margin of the distance under which a site can clip a cell
+#define HALF_PLANE_RADIUS_MARGIN 1e-9
+//Smallest sine of the angle between the lines of a corner for the floating point filter of its side
+#define HALF_PLANE_CONDITION 1e-4
+//Relative error bound of the floating point side of a well conditioned corner
+#define HALF_PLANE_FILTER 1e-8
+
+namespace Voronoi {
+
+    namespace internal {
+
+        /**
+         * @brief The HalfPlaneCorner struct, a vertex of a cell of halfPlaneAlgorithm relatively to its site, with the tag
+         * of the edge from it to the next vertex: the index of the other site or a side of the box (boxSideTag).
+         * distance is the squared distance from the site, filtered is true if the lines of the corner are not almost parallel,
+         * so its coordinates are accurate
+         */
+        struct HalfPlaneCorner {
+            double x, y, distance;
+            size_t tag;
+            bool filtered;
+        };
+
+        struct HalfPlanePolygon {
+            HalfPlaneCorner corners[HALF_PLANE_CAPACITY + 4];
+            size_t size;
+        };
+
+        /**
+         * @brief halfPlaneCorner the corner of the cell of site between the edges previous and tag
+         */
+        HalfPlaneCorner halfPlaneCorner(const cg3::Point2Dd& site, size_t previous, size_t tag,
+                                        const SiteSpan& points, const cg3::BoundingBox2D& box) {
+            HalfPlaneCorner corner = {0, 0, 0, tag, true};
+            if(!isBoxSideTag(previous) && !isBoxSideTag(tag)) {
+                //circumcenter
+                double bx = points[previous].x() - site.x(), by = points[previous].y() - site.y();
+                double cx = points[tag].x() - site.x(), cy = points[tag].y() - site.y();
+                double det = bx*cy - by*cx, b2 = bx*bx + by*by, c2 = cx*cx + cy*cy;
+                corner.x = (cy*b2 - by*c2)/(2*det);
+                corner.y = (bx*c2 - cx*b2)/(2*det);
+                corner.filtered = det*det > HALF_PLANE_CONDITION*HALF_PLANE_CONDITION*b2*c2;
+            } else if(!isBoxSideTag(previous) || !isBoxSideTag(tag)) {
+                //intersection of the bisector with the side of the box
+                int side = boxSide(isBoxSideTag(previous) ? previous : tag);
+                const cg3::Point2Dd& other = points[isBoxSideTag(previous) ? tag : previous];
+                double bx = other.x() - site.x(), by = other.y() - site.y(), b2 = bx*bx + by*by;
+                if(side == 0 || side == 2) {
+                    corner.y = (side == 0 ? box.min().y() : box.max().y()) - site.y();
+                    corner.x = bx != 0 ? (b2/2 - corner.y*by)/bx : 0;
+                    corner.x = std::min(std::max(corner.x, box.min().x() - site.x()), box.max().x() - site.x());
+                    corner.filtered = bx*bx > HALF_PLANE_CONDITION*HALF_PLANE_CONDITION*b2;
+                } else {
+                    corner.x = (side == 1 ? box.max().x() : box.min().x()) - site.x();
+                    corner.y = by != 0 ? (b2/2 - corner.x*bx)/by : 0;
+                    corner.y = std::min(std::max(corner.y, box.min().y() - site.y()), box.max().y() - site.y());
+                    corner.filtered = by*by > HALF_PLANE_CONDITION*HALF_PLANE_CONDITION*b2;
+                }
+            } else {
+                //corner of the box
+                int s1 = boxSide(previous), s2 = boxSide(tag);
+                bool top = s1 == 2 || s2 == 2, right = s1 == 1 || s2 == 1;
+                corner.x = (right ? box.max().x() : box.min().x()) - site.x();
+                corner.y = (top ? box.max().y() : box.min().y()) - site.y();
+            }
+            corner.distance = corner.x*corner.x + corner.y*corner.y;
+            return corner;
+        }
+
+        /**
+         * @brief cellRadius the squared distance of the farthest corner of the polygon from its site
+         */
+        inline double cellRadius(const HalfPlanePolygon& polygon) {
+            double radius = 0;
+            for(size_t i = 0; i < polygon.size; i++)
+                radius = std::max(radius, polygon.corners[i].distance);
+            return radius;
+        }
+
+        /**
+         * @brief exactCornerSide the side of the bisector of site and other where the corner between the edges previous and tag lies,
+         * when the floating point side d of its coordinates is uncertain: positive on the side of other.
+         * The corner of two sites is their circumcenter with site, so its side is given by the exact in-circle test,
+         * and the circle of a corner on a side of the box passes through the reflection of site across the side
+         */
+        int exactCornerSide(const HalfPlaneCorner& corner, size_t previous, const cg3::Point2Dd& site, const cg3::Point2Dd& other,
+                            double d, const SiteSpan& points, const cg3::BoundingBox2D& box) {
+            if(!isBoxSideTag(previous) || !isBoxSideTag(corner.tag)) {
+                cg3::Point2Dd third;
+                size_t neighbour;
+                if(isBoxSideTag(previous) || isBoxSideTag(corner.tag)) {
+                    int side = boxSide(isBoxSideTag(previous) ? previous : corner.tag);
+                    neighbour = isBoxSideTag(previous) ? corner.tag : previous;
+                    if(side == 0 || side == 2)
+                        third = cg3::Point2Dd(site.x(), 2*(side == 0 ? box.min().y() : box.max().y()) - site.y());
+                    else
+                        third = cg3::Point2Dd(2*(side == 1 ? box.max().x() : box.min().x()) - site.x(), site.y());
+                } else {
+                    neighbour = previous;
+                    third = points[corner.tag];
+                }
+                int orientation = exactOrientation(site, points[neighbour], third);
+                if(orientation != 0)
+                    return orientation*exactInCircle(site, points[neighbour], third, other);
+            }
+            return (d > 0) - (d < 0);
+        }
+
+        /**
+         * @brief clipPolygon Sutherland-Hodgman clipping of the cell of site with the half-plane of the points nearer
+         * to site than to points[tag]. The corners on the bisector stay, so cocircular sites meet in a single vertex
+         * whatever the order of the clips
+         * @return false if the polygon is not clipped, otherwise the clipped polygon is in buffer
+         */
+        bool clipPolygon(const HalfPlanePolygon& polygon, const cg3::Point2Dd& site, size_t tag,
+                         const SiteSpan& points, const cg3::BoundingBox2D& box, HalfPlanePolygon& buffer) {
+            const cg3::Point2Dd& other = points[tag];
+            const double ox = other.x() - site.x(), oy = other.y() - site.y(), o2 = ox*ox + oy*oy;
+            const size_t n = polygon.size;
+            int sides[HALF_PLANE_CAPACITY + 4];
+            bool outside = false;
+            for(size_t i = 0; i < n; i++) {
+                //squared distance from site minus squared distance from other, the coordinates decide if it is far from zero
+                const HalfPlaneCorner& corner = polygon.corners[i];
+                double d = 2*(corner.x*ox + corner.y*oy) - o2;
+                if(corner.filtered && std::fabs(d) > HALF_PLANE_FILTER*(2*corner.distance - d))
+                    sides[i] = d > 0 ? 1 : -1;
+                else
+                    sides[i] = exactCornerSide(corner, polygon.corners[i > 0 ? i-1 : n-1].tag, site, other, d, points, box);
+                outside = outside || sides[i] > 0;
+            }
+            if(!outside)
+                return false;
+
+            buffer.size = 0;
+            for(size_t i = 0; i < n; i++) {
+                const HalfPlaneCorner& a = polygon.corners[i];
+                int sa = sides[i], sb = sides[i+1 < n ? i+1 : 0];
+                if(sa <= 0) {
+                    buffer.corners[buffer.size++] = a;
+                    if(sb > 0) {
+                        if(sa < 0)
+                            buffer.corners[buffer.size++] = halfPlaneCorner(site, a.tag, tag, points, box);
+                        else
+                            buffer.corners[buffer.size-1].tag = tag;
+                    }
+                } else if(sb < 0)
+                    buffer.corners[buffer.size++] = halfPlaneCorner(site, tag, a.tag, points, box);
+            }
+            return true;
+        }
+
+    }
+
+    /**
+     * @brief halfPlaneAlgorithm computes the same diagram of fortuneAlgorithm clipping the box with the bisectors
+     * of each site and the others, in O(n^2) time, for the tiny diagrams where the setup of the sweep costs more
+     * than the sweep itself: the buffers are on the stack and the DCEL is reserved once.
+     * The cell of a site is clipped by the nearest sites first, then by the others near enough to clip it.
+     * The corners are decided by filtered exact predicates, so the cells of degenerate sites (grids, circles) agree on their
+     * edges; the halfEdges between two cells and their vertexs are created by the first of the two cells.
+     * Sites equal to a previous one get a face without a cell, linked to the one with the cell. More than 64 sites are computed by fortuneAlgorithm
+     * @param points: the sites of the diagram
+     * @param dcel: the DCEL where the diagram is stored
+     * @param boundingBox: the box used to clip the diagram, the cells are closed by its boundary
+     */
+    void halfPlaneAlgorithm(const SiteSpan& points, DCEL& dcel,
+                            const cg3::BoundingBox2D& boundingBox) {
+        const size_t null = std::numeric_limits<size_t>::max();
+        const size_t n = points.size();
+        if(n > HALF_PLANE_CAPACITY) {
+            fortuneAlgorithm(points, dcel, boundingBox);
+            return;
+        }
+
+        dcel.fitOrigin(boundingBox);
+        size_t firstFace = dcel.getFaces().size();
+        dcel.getFaces().reserve(firstFace + n);
+        for(size_t i = 0; i < n; i++)
+            dcel.addFace(Face(points[i]));
+        dcel.getHalfEdges().reserve(dcel.getHalfEdges().size() + 6*n + 8);
+        dcel.getVertexs().reserve(dcel.getVertexs().size() + 2*n + 4);
+
+        std::vector<Face>& faces = dcel.getFaces();
+        std::vector<HalfEdge>& edges = dcel.getHalfEdges();
+        std::vector<Vertex>& vertexs = dcel.getVertexs();
+
+        //The sites sorted by x and y: the copies of a site are adjacent, only the first one gets a cell
+        size_t order[HALF_PLANE_CAPACITY];
+        bool duplicate[HALF_PLANE_CAPACITY];
+        for(size_t i = 0; i < n; i++)
+            order[i] = i;
+        std::sort(order, order + n, [&](size_t a, size_t b) {
+            return points[a].x() < points[b].x() || (points[a].x() == points[b].x() && (points[a].y() < points[b].y() ||
+                                                                                     (points[a].y() == points[b].y() && a < b)));
+        });
+        for(size_t i = 0; i < n; i++) {
+            duplicate[order[i]] = i > 0 && points[order[i]] == points[order[i-1]];
+            if(duplicate[order[i]])
+                dcel.linkCoincidentFaces(firstFace + order[i-1], firstFace + order[i]);
+        }
+
+        //pairEdges[i*n + j]: the halfEdge of the cell of i on the bisector with j
+        size_t pairEdges[HALF_PLANE_CAPACITY*HALF_PLANE_CAPACITY];
+        std::fill(pairEdges, pairEdges + n*n, null);
+        size_t outerEdges[4*HALF_PLANE_CAPACITY + 4], nOuterEdges = 0;
+        size_t polygonVertexs[HALF_PLANE_CAPACITY + 4], polygonEdges[HALF_PLANE_CAPACITY + 4];
+        internal::HalfPlanePolygon polygons[2];
+        double distances[HALF_PLANE_CAPACITY];
+        size_t others[HALF_PLANE_CAPACITY];
+
+        for(size_t i = 0; i < n; i++) {
+            if(duplicate[i])
+                continue;
+            const cg3::Point2Dd& site = points[i];
+            const size_t face = firstFace + i;
+
+            internal::HalfPlanePolygon* polygon = &polygons[0];
+            internal::HalfPlanePolygon* buffer = &polygons[1];
+            for(int side = 0; side < 4; side++)
+                polygon->corners[side] = internal::halfPlaneCorner(site, internal::boxSideTag((side + 3) % 4), internal::boxSideTag(side),
+                                                                   points, boundingBox);
+            polygon->size = 4;
+
+            double radius = internal::cellRadius(*polygon)*(1 + HALF_PLANE_RADIUS_MARGIN);
+            //The nearest sites give most of the cell, then the others clip it only if they are near enough
+            size_t nOthers = 0;
+            for(size_t j = 0; j < n; j++) {
+                double dx = points[j].x() - site.x(), dy = points[j].y() - site.y();
+                if(j != i && !duplicate[j]) {
+                    distances[nOthers] = dx*dx + dy*dy;
+                    others[nOthers++] = j;
+                }
+            }
+            for(size_t k = 0; k < nOthers && polygon->size >= 3; k++) {
+                if(k < HALF_PLANE_NEAREST) {
+                    size_t nearest = std::min_element(distances + k, distances + nOthers) - distances;
+                    std::swap(distances[k], distances[nearest]);
+                    std::swap(others[k], others[nearest]);
+                }
+                //the bisector is at half the distance of the other site
+                if(distances[k] <= 4*radius && internal::clipPolygon(*polygon, site, others[k], points, boundingBox, *buffer)) {
+                    std::swap(polygon, buffer);
+                    radius = internal::cellRadius(*polygon)*(1 + HALF_PLANE_RADIUS_MARGIN);
+                }
+            }
+            if(polygon->size < 3)
+                continue;
+
+            //Vertexs: the ones of an earlier neighbour are the ends of its halfEdges
+            const size_t m = polygon->size;
+            for(size_t j = 0; j < m; j++) {
+                size_t previous = polygon->corners[j > 0 ? j-1 : m-1].tag, tag = polygon->corners[j].tag, vertex = null;
+                if(!internal::isBoxSideTag(tag) && pairEdges[i*n + tag] != null)
+                    vertex = edges[edges[dcel.getTwinID(pairEdges[i*n + tag])].getNextID()].getOriginID();
+                if(!internal::isBoxSideTag(previous) && pairEdges[i*n + previous] != null) {
+                    size_t copy = edges[dcel.getTwinID(pairEdges[i*n + previous])].getOriginID();
+                    if(vertex == null)
+                        vertex = copy;
+                    else if(copy != vertex) {
+                        //Two cells around cocircular sites, not adjacent, created the vertex twice
+                        for(size_t k = 0; k < i; k++) {
+                            size_t start = faces[firstFace + k].getIncidEdgeID(), e = start;
+                            if(duplicate[k] || start == null)
+                                continue;
+                            do {
+                                if(edges[e].getOriginID() == copy)
+                                    edges[e].setOrigin(vertex);
+                                e = edges[e].getNextID();
+                            } while(e != start);
+                        }
+                        for(size_t k = 0; k < nOuterEdges; k++) {
+                            if(edges[outerEdges[k]].getOriginID() == copy)
+                                edges[outerEdges[k]].setOrigin(vertex);
+                        }
+                        std::replace(polygonVertexs, polygonVertexs + j, copy, vertex);
+                        dcel.removeVertex(copy);
+                    }
+                }
+                if(vertex == null) {
+                    const internal::HalfPlaneCorner& corner = polygon->corners[j];
+                    vertex = dcel.addVertex(dcel.makeVertex(cg3::Point2Dd(site.x() + corner.x, site.y() + corner.y)));
+                }
+                polygonVertexs[j] = vertex;
+            }
+
+            //HalfEdges: the twin of an earlier neighbour, or a new pair
+            for(size_t j = 0; j < m; j++) {
+                size_t tag = polygon->corners[j].tag, e;
+                if(internal::isBoxSideTag(tag)) {
+                    e = dcel.addHalfEdgePair(face, null);
+                    edges[e+1].setOrigin(polygonVertexs[j+1 < m ? j+1 : 0]);
+                    outerEdges[nOuterEdges++] = e+1;
+                } else if(pairEdges[i*n + tag] != null)
+                    e = pairEdges[i*n + tag];
+                else {
+                    e = dcel.addHalfEdgePair(face, firstFace + tag);
+                    pairEdges[i*n + tag] = e;
+                    pairEdges[tag*n + i] = e+1;
+                }
+                edges[e].setOrigin(polygonVertexs[j]);
+                vertexs[polygonVertexs[j]].setIncidEdge(e);
+                polygonEdges[j] = e;
+            }
+            for(size_t j = 0; j < m; j++) {
+                size_t next = polygonEdges[j+1 < m ? j+1 : 0];
+                edges[polygonEdges[j]].setNext(next);
+                edges[next].setPrev(polygonEdges[j]);
+            }
+            faces[face].setIncidEdge(polygonEdges[0]);
+        }
+
+        //The halfEdges outside the box are linked to the ones starting where they end, the boundary is short
+        for(size_t k = 0; k < nOuterEdges; k++) {
+            size_t end = edges[dcel.getTwinID(outerEdges[k])].getOriginID();
+            for(size_t l = 0; l < nOuterEdges; l++) {
+                if(edges[outerEdges[l]].getOriginID() == end) {
+                    edges[outerEdges[k]].setNext(outerEdges[l]);
+                    edges[outerEdges[l]].setPrev(outerEdges[k]);
+                    break;
+                }
+            }
+        }
+    }
+
+}
@@ -0,0 +1,15 @@
+#ifndef HALFPLANE_H
+#define HALFPLANE_H
+
+#include "../data_structures/dcel.h"
+#include "../data_structures/sitespan.h"
+#include <cg3/geometry/2d/bounding_box2d.h>
+
+namespace Voronoi {
+
+    void halfPlaneAlgorithm(const SiteSpan& points, DCEL& dcel,
+                            const cg3::BoundingBox2D& boundingBox);
+
+}
+
+#endif // HALFPLANE_H
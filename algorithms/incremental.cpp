@@ -0,0 +1,152 @@
+#include "incremental.h"
+
+#include <algorithm>
+
+namespace Voronoi {
+
+    /**
+     * @brief insertSite adds a site to a diagram, changing only the cells around the new one (see insertFace)
+     * @param site: the new site, it must be inside the bounding box
+     * @param dcel: a diagram computed by fortuneAlgorithm with boundingBox, or an empty DCEL
+     * @param boundingBox: the box of the diagram
+     * @param hint: a face near the site, e.g. the one of the previous insertion
+     * @return the face of the new site, the slot of a removed face or a new one after the others. A site equal to an existing one
+     * gets a face without a cell, in the ring of coincident faces of the one with the cell (DCEL::getCoincidentFace).
+     * If the site is outside the box std::numeric_limits<size_t>::max() is returned and the diagram is not changed
+     */
+    size_t insertSite(const cg3::Point2Dd& site, DCEL& dcel, const cg3::BoundingBox2D& boundingBox, size_t hint) {
+        if(!boundingBox.isInside(site))
+            return std::numeric_limits<size_t>::max();
+        size_t face = dcel.reuseFace(Face(site));
+        insertFace(face, dcel, boundingBox, hint);
+        return face;
+    }
+
+    /**
+     * @brief insertFace gives a cell to a face of the diagram without one, changing only the cells around it.
+     * The cell containing the site is located with a walk from hint, then the cells that lose part of their
+     * region to the new site (the ones with a vertex not farther from the new site than from their own) are found
+     * by a visit of the neighbours, and only these cells and the new one are rebuilt
+     * @param face: a face without a cell, its site inside the box; it is taken out of its ring of coincident faces
+     * @param dcel: a diagram computed by fortuneAlgorithm with boundingBox, or updated by insertSite
+     * @param boundingBox: the box of the diagram
+     * @param hint: a face near the site
+     * @return the face with the cell of the site: face, or the face of an equal site whose ring it joins
+     */
+    size_t insertFace(size_t face, DCEL& dcel, const cg3::BoundingBox2D& boundingBox, size_t hint) {
+        const size_t null = std::numeric_limits<size_t>::max();
+        const cg3::Point2Dd site = dcel.getFaces()[face].getSite();
+        dcel.unlinkCoincidentFace(face);
+        size_t containing = locateSite(dcel, site, hint);
+        if(containing != null && dcel.getFaces()[containing].getSite() == site) {
+            dcel.linkCoincidentFaces(containing, face);
+            return containing;
+        }
+
+        //Cells that lose part of their region, or touch the new cell in a vertex: a convex cell intersects the half-plane nearer to site
+        //only if one of its vertexs does
+        const std::vector<HalfEdge>& edges = dcel.getHalfEdges();
+        const std::vector<Face>& faces = dcel.getFaces();
+        std::vector<size_t> changed, stack, neighbours;
+        if(containing != null) {
+            changed.push_back(containing);
+            stack.push_back(containing);
+        }
+        while(!stack.empty()) {
+            size_t current = stack.back();
+            stack.pop_back();
+            findNeighbours(dcel, current, neighbours);
+            for(size_t neighbour : neighbours) {
+                if(std::find(changed.begin(), changed.end(), neighbour) != changed.end())
+                    continue;
+                const cg3::Point2Dd neighbourSite = faces[neighbour].getSite();
+                size_t start = faces[neighbour].getIncidEdgeID(), e = start;
+                bool isChanged = false;
+                do {
+                    const cg3::Point2Dd v = dcel.getVertexCoordinates(edges[e].getOriginID());
+                    if(v.dist(site) <= v.dist(neighbourSite)) {
+                        isChanged = true;
+                        break;
+                    }
+                    e = edges[e].getNextID();
+                } while(e != start && e != null);
+                if(isChanged) {
+                    changed.push_back(neighbour);
+                    stack.push_back(neighbour);
+                }
+            }
+        }
+
+        changed.push_back(face);
+        rebuildCells(dcel, boundingBox, changed, std::vector<size_t>());
+        return face;
+    }
+
+    /**
+     * @brief insertSites adds a batch of sites to a diagram, one after the other, each search starting from
+     * the face of the previous site
+     * @param sites: the new sites, the ones outside the box are not added
+     * @param dcel: a diagram computed by fortuneAlgorithm with boundingBox, or an empty DCEL
+     * @param boundingBox: the box of the diagram
+     * @param faces: if not null, it gets the face of each site, as returned by insertSite
+     */
+    void insertSites(const std::vector<cg3::Point2Dd>& sites, DCEL& dcel, const cg3::BoundingBox2D& boundingBox,
+                     std::vector<size_t>* faces) {
+        size_t hint = std::numeric_limits<size_t>::max();
+        if(faces != nullptr)
+            faces->clear();
+        for(const cg3::Point2Dd& site : sites) {
+            size_t face = insertSite(site, dcel, boundingBox, hint);
+            if(face != std::numeric_limits<size_t>::max())
+                hint = face;
+            if(faces != nullptr)
+                faces->push_back(face);
+        }
+    }
+
+    /**
+     * @brief removeSite removes a site, the region of its cell is shared among its neighbours, which are
+     * the only cells rebuilt. If other faces have the same site, the cell is handed to one of them instead, and no cell changes.
+     * The face is removed from the DCEL (DCEL::removeFace): the indices of the other faces do not change,
+     * and the next insertSite reuses it
+     * @param face: the face of the site to remove
+     * @param dcel: a diagram computed by fortuneAlgorithm with boundingBox, or updated by insertSite
+     * @param boundingBox: the box of the diagram
+     * @return false if the face was already removed
+     */
+    bool removeSite(size_t face, DCEL& dcel, const cg3::BoundingBox2D& boundingBox) {
+        const size_t null = std::numeric_limits<size_t>::max();
+        if(face >= dcel.getFaces().size() || dcel.isFaceRemoved(face))
+            return false;
+
+        std::vector<Face>& faces = dcel.getFaces();
+        const size_t coincident = dcel.getCoincidentFace(face);
+        if(faces[face].getIncidEdgeID() == null) {
+            dcel.removeFace(face);
+            return true;
+        }
+
+        //A copy of the site takes the cell as it is
+        if(coincident != face) {
+            std::vector<HalfEdge>& edges = dcel.getHalfEdges();
+            size_t start = faces[face].getIncidEdgeID(), e = start;
+            do {
+                edges[e].setFace(coincident);
+                e = edges[e].getNextID();
+            } while(e != start && e != null);
+            faces[coincident].setIncidEdge(start);
+            faces[face].setIncidEdge(null);
+            dcel.removeFace(face);
+            return true;
+        }
+
+        std::vector<size_t> neighbours;
+        findNeighbours(dcel, face, neighbours);
+        std::sort(neighbours.begin(), neighbours.end());
+        neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+        rebuildCells(dcel, boundingBox, neighbours, std::vector<size_t>(1, face));
+        dcel.removeFace(face);
+        return true;
+    }
+
+}
@@ -0,0 +1,18 @@
+#ifndef INCREMENTAL_H
+#define INCREMENTAL_H
+
+#include "cellrebuild.h"
+
+namespace Voronoi {
+
+    size_t insertSite(const cg3::Point2Dd& site, DCEL& dcel, const cg3::BoundingBox2D& boundingBox,
+                      size_t hint = std::numeric_limits<size_t>::max());
+    size_t insertFace(size_t face, DCEL& dcel, const cg3::BoundingBox2D& boundingBox,
+                      size_t hint = std::numeric_limits<size_t>::max());
+    void insertSites(const std::vector<cg3::Point2Dd>& sites, DCEL& dcel, const cg3::BoundingBox2D& boundingBox,
+                     std::vector<size_t>* faces = nullptr);
+    bool removeSite(size_t face, DCEL& dcel, const cg3::BoundingBox2D& boundingBox);
+
+}
+
+#endif // INCREMENTAL_H
@@ -0,0 +1,158 @@
+#include "jumpflooding.h"
+
+#include <algorithm>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+//Under this number of pixels the passes run on a single thread
+#define JUMP_FLOODING_PARALLEL_MIN_SIZE 65536
+
+namespace Voronoi {
+
+    namespace internal {
+
+        /**
+         * @brief jumpFloodingPass a pass of the jump flooding with step k: each pixel takes the nearest site
+         * among its own and the ones of the 8 pixels at distance k along the rows, the columns and the diagonals.
+         * The columns of a row are visited in SIMD loops, one for each of the 9 pixels, the rows are split among the threads.
+         * The sites are indexed by the labels in siteX and siteY, in pixel units; the distances along x and y are scaled
+         * by scaleX and scaleY, the sides of the pixels
+         */
+        void jumpFloodingPass(const std::vector<uint32_t>& source, std::vector<uint32_t>& destination,
+                              const std::vector<float>& siteX, const std::vector<float>& siteY, float scaleX, float scaleY,
+                              long long width, long long height, long long k, int nThreads) {
+            const uint32_t* in = source.data();
+            uint32_t* out = destination.data();
+            const float* sx = siteX.data();
+            const float* sy = siteY.data();
+
+            #pragma omp parallel num_threads(nThreads) if(nThreads > 1)
+            {
+                std::vector<float> best(static_cast<size_t>(width));
+                float* distances = best.data();
+
+                #pragma omp for
+                for(long long row = 0; row < height; row++) {
+                    const float y = static_cast<float>(row);
+                    const uint32_t* own = in + row*width;
+                    uint32_t* labels = out + row*width;
+
+                    #pragma omp simd
+                    for(long long x = 0; x < width; x++) {
+                        uint32_t label = own[x];
+                        float dx = (sx[label] - static_cast<float>(x))*scaleX, dy = (sy[label] - y)*scaleY;
+                        distances[x] = dx*dx + dy*dy;
+                        labels[x] = label;
+                    }
+
+                    for(int oy = -1; oy <= 1; oy++) {
+                        long long other = row + oy*k;
+                        if(other < 0 || other >= height)
+                            continue;
+                        for(int ox = -1; ox <= 1; ox++) {
+                            if(ox == 0 && oy == 0)
+                                continue;
+                            const long long shift = ox*k;
+                            const long long begin = std::max(0LL, -shift), end = std::min(width, width - shift);
+                            const uint32_t* candidates = in + other*width + shift;
+
+                            #pragma omp simd
+                            for(long long x = begin; x < end; x++) {
+                                uint32_t label = candidates[x];
+                                float dx = (sx[label] - static_cast<float>(x))*scaleX, dy = (sy[label] - y)*scaleY;
+                                float distance = dx*dx + dy*dy;
+                                if(distance < distances[x]) {
+                                    distances[x] = distance;
+                                    labels[x] = label;
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+    }
+
+    /**
+     * @brief jumpFloodingDiagram computes an approximation of the diagram on a raster: each pixel of labels gets the index
+     * in points of the nearest site to its center, or JUMP_FLOODING_NO_SITE if no site is inside the box.
+     * The sites are put in the pixels containing them and propagated by the jump flooding algorithm, with steps halving
+     * from half the size of the raster down to 1, and two more passes with steps 2 and 1 that fix most of the wrong pixels.
+     * The sites outside the box are ignored, as the sites sharing a pixel with a nearer one
+     * @param points: the sites
+     * @param boundingBox: the box covered by the raster
+     * @param width: the number of columns, along x
+     * @param height: the number of rows, along y
+     * @param labels: the raster, labels(i, j) is the pixel in the row i from the bottom of the box and in the column j from its left
+     * @param nThreads: the number of threads, 0 to use the OpenMP default
+     */
+    void jumpFloodingDiagram(const std::vector<cg3::Point2Dd>& points, const cg3::BoundingBox2D& boundingBox,
+                             unsigned int width, unsigned int height, cg3::Array2D<uint32_t>& labels, int nThreads) {
+        labels.resize(height, width);
+        if(width == 0 || height == 0)
+            return;
+        const size_t pixels = static_cast<size_t>(width)*height;
+        #ifdef _OPENMP
+        if(nThreads <= 0)
+            nThreads = omp_get_max_threads();
+        if(pixels < JUMP_FLOODING_PARALLEL_MIN_SIZE)
+            nThreads = 1;
+        #else
+        nThreads = 1;
+        #endif
+
+        //Sites in pixel units (the center of the pixel (i, j) is (j, i)); the last one is the missing site, farther than any other
+        const uint32_t missing = static_cast<uint32_t>(points.size());
+        const double pixelWidth = (boundingBox.max().x() - boundingBox.min().x())/width;
+        const double pixelHeight = (boundingBox.max().y() - boundingBox.min().y())/height;
+        std::vector<float> siteX(points.size() + 1), siteY(points.size() + 1);
+        for(size_t i = 0; i < points.size(); i++) {
+            siteX[i] = static_cast<float>((points[i].x() - boundingBox.min().x())/pixelWidth - 0.5);
+            siteY[i] = static_cast<float>((points[i].y() - boundingBox.min().y())/pixelHeight - 0.5);
+        }
+        siteX[missing] = siteY[missing] = 1e18f;
+        const float scaleX = static_cast<float>(pixelWidth/std::max(pixelWidth, pixelHeight));
+        const float scaleY = static_cast<float>(pixelHeight/std::max(pixelWidth, pixelHeight));
+
+        //Seeds: each site in its pixel, the nearest to the center if more sites share it
+        std::vector<uint32_t> current(pixels, missing), next(pixels);
+        for(size_t i = 0; i < points.size(); i++) {
+            if(!boundingBox.isInside(points[i]))
+                continue;
+            size_t column = std::min(static_cast<size_t>(std::max(siteX[i] + 0.5f, 0.0f)), static_cast<size_t>(width - 1));
+            size_t row = std::min(static_cast<size_t>(std::max(siteY[i] + 0.5f, 0.0f)), static_cast<size_t>(height - 1));
+            uint32_t& seed = current[row*width + column];
+            float dx = (siteX[i] - column)*scaleX, dy = (siteY[i] - row)*scaleY;
+            float seedX = (siteX[seed] - column)*scaleX, seedY = (siteY[seed] - row)*scaleY;
+            if(seed == missing || dx*dx + dy*dy < seedX*seedX + seedY*seedY)
+                seed = static_cast<uint32_t>(i);
+        }
+
+        std::vector<long long> steps;
+        long long k = 1;
+        while(k < std::max(width, height))
+            k *= 2;
+        for(k /= 2; k >= 1; k /= 2)
+            steps.push_back(k);
+        steps.push_back(2);
+        steps.push_back(1);
+        for(long long step : steps) {
+            internal::jumpFloodingPass(current, next, siteX, siteY, scaleX, scaleY, width, height, step, nThreads);
+            current.swap(next);
+        }
+
+        const long long rows = height;
+        #pragma omp parallel for num_threads(nThreads) if(nThreads > 1)
+        for(long long row = 0; row < rows; row++) {
+            uint32_t* destination = &labels(static_cast<unsigned long>(row), 0ul);
+            const uint32_t* source = current.data() + row*width;
+            for(unsigned int column = 0; column < width; column++)
+                destination[column] = source[column] != missing ? source[column] : JUMP_FLOODING_NO_SITE;
+        }
+    }
+
+}
@@ -0,0 +1,22 @@
+#ifndef JUMPFLOODING_H
+#define JUMPFLOODING_H
+
+#include <cstdint>
+#include <limits>
+
+#include <cg3/geometry/2d/bounding_box2d.h>
+#include <cg3/data_structures/arrays/array2d.h>
+
+namespace Voronoi {
+
+    /**
+     * @brief JUMP_FLOODING_NO_SITE the label of the pixels without a site, when there are no sites in the box
+     */
+    const uint32_t JUMP_FLOODING_NO_SITE = std::numeric_limits<uint32_t>::max();
+
+    void jumpFloodingDiagram(const std::vector<cg3::Point2Dd>& points, const cg3::BoundingBox2D& boundingBox,
+                             unsigned int width, unsigned int height, cg3::Array2D<uint32_t>& labels, int nThreads = 0);
+
+}
+
+#endif // JUMPFLOODING_H
@@ -0,0 +1,167 @@
+#include "kinetic.h"
+
+#include "incremental.h"
+
+#include <assert.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+//Fraction of the cells with a site whose change makes moveSites recompute the whole diagram.
+//Rebuilding a cell costs about six times its share of a sweep (12 us against 2 us for 20000 uniform sites), on top of
+//5 ms of certificates, so the two paths cost the same at about 10% of the cells: with a mean distance d between the sites
+//this is a motion of about d/400 per frame, larger motions are faster computed again
+#define KINETIC_REBUILD_RATIO 0.1
+//Under this number of halfEdges a single thread is used
+#define KINETIC_PARALLEL_MIN_SIZE 65536
+
+namespace Voronoi {
+
+    /**
+     * @brief moveSites updates a diagram after the motion of its sites, without computing it again.
+     * The vertexs are moved to the positions given by their sites (or sides of the box), then each halfEdge is checked:
+     * if its cell is not on its left anymore, or the site of the next cell around its end is nearer to its origin than its own site,
+     * the topology around it has changed (an edge collapsed, a site entered the circle of a vertex, or a vertex crossed the box).
+     * Only the cells around the broken edges are rebuilt, so the cost of the repair follows the amount of topology change.
+     * If the sites moved too much (a site left the box, too many cells changed, or the rebuilt cells do not match their neighbours)
+     * the whole diagram is computed again.
+     * A face without a cell whose site does not coincide anymore with the one of the cell of its ring (a duplicate site that
+     * moved apart) leaves the ring and gets its own cell, or joins the ring of another equal site. The removed faces stay removed
+     * @param sites: the new position of the site of each face, the ones of the removed faces are not used
+     * @param dcel: a diagram computed by fortuneAlgorithm with boundingBox, or updated by insertSite, removeSite or moveSites
+     * @param boundingBox: the box of the diagram
+     * @param statistics: if not null, it is filled with the counters of the update
+     */
+    void moveSites(const std::vector<cg3::Point2Dd>& sites, DCEL& dcel, const cg3::BoundingBox2D& boundingBox,
+                   KineticStatistics* statistics) {
+        std::vector<HalfEdge>& edges = dcel.getHalfEdges();
+        std::vector<Vertex>& vertexs = dcel.getVertexs();
+        std::vector<Face>& faces = dcel.getFaces();
+        const size_t null = std::numeric_limits<size_t>::max();
+        KineticStatistics kineticStatistics;
+
+        assert(sites.size() == faces.size());
+        size_t nCells = 0;
+        bool isOutside = false;
+        for(size_t f = 0; f < faces.size(); f++) {
+            faces[f].setSite(sites[f]);
+            if(faces[f].getIncidEdgeID() != null) {
+                nCells++;
+                isOutside = isOutside || !boundingBox.isInside(sites[f]);
+            }
+        }
+
+        //Duplicate sites that moved apart from the cell of their ring need a cell of their own
+        std::vector<size_t> separated;
+        for(size_t f = 0; f < faces.size(); f++) {
+            if(faces[f].getIncidEdgeID() == null && !dcel.isFaceRemoved(f) && !internal::hasCoincidentCell(dcel, f)) {
+                separated.push_back(f);
+                isOutside = isOutside || !boundingBox.isInside(sites[f]);
+            }
+        }
+        kineticStatistics.separatedSites = separated.size();
+
+        int nThreads = 1;
+        #ifdef _OPENMP
+        if(edges.size() >= KINETIC_PARALLEL_MIN_SIZE)
+            nThreads = omp_get_max_threads();
+        #endif
+
+        if(!isOutside) {
+            //New positions of the vertexs, from the constraints around their incident halfEdge
+            //(a halfEdge outside the box is replaced by the one inside the box leaving the same vertex)
+            const long long nVertexs = static_cast<long long>(vertexs.size());
+            std::vector<cg3::Point2Dd> positions(vertexs.size());
+            #pragma omp parallel for num_threads(nThreads) if(nThreads > 1)
+            for(long long v = 0; v < nVertexs; v++) {
+                size_t e = vertexs[v].getIncidEdgeID();
+                if(e == null)
+                    continue;
+                if(edges[e].getFaceID() == null)
+                    e = edges[dcel.getTwinID(e)].getNextID();
+                internal::VertexKey key = internal::vertexKey(edges[e].getFaceID(),
+                                                              internal::edgeTag(dcel, edges[e].getPrevID(), boundingBox),
+                                                              internal::edgeTag(dcel, e, boundingBox));
+                positions[v] = internal::vertexPosition(key, faces, boundingBox);
+            }
+            #pragma omp parallel for num_threads(nThreads) if(nThreads > 1)
+            for(long long v = 0; v < nVertexs; v++) {
+                if(vertexs[v].getIncidEdgeID() != null)
+                    dcel.setVertexCoordinates(v, positions[v]);
+            }
+
+            //Certificates: each halfEdge must have the site of its face on its left, and the site of the cell after its end
+            //must not be nearer to its origin than the site of its face (the circle of the vertex is empty: on the box,
+            //no cell reached the side or the corner between the two cells of the vertex)
+            const long long nHalfEdges = static_cast<long long>(edges.size());
+            std::vector<char> broken(edges.size()/2, 0);
+            #pragma omp parallel for num_threads(nThreads) if(nThreads > 1)
+            for(long long e = 0; e < nHalfEdges; e++) {
+                size_t face = edges[e].getFaceID();
+                if(edges[e].getOriginID() == null || face == null)
+                    continue;
+                cg3::Point2Dd a = dcel.getVertexCoordinates(edges[e].getOriginID());
+                cg3::Point2Dd b = dcel.getVertexCoordinates(edges[dcel.getTwinID(e)].getOriginID());
+                cg3::Point2Dd s = faces[face].getSite();
+                double orientation = (b.x() - a.x())*(s.y() - a.y()) - (b.y() - a.y())*(s.x() - a.x());
+                if(!(orientation > 0))
+                    broken[e/2] = 1;
+                size_t opposite = edges[dcel.getTwinID(edges[e].getNextID())].getFaceID();
+                if(opposite != null) {
+                    cg3::Point2Dd o = faces[opposite].getSite();
+                    if((o.x() - a.x())*(o.x() - a.x()) + (o.y() - a.y())*(o.y() - a.y()) <
+                            (s.x() - a.x())*(s.x() - a.x()) + (s.y() - a.y())*(s.y() - a.y()))
+                        broken[e/2] = 1;
+                }
+            }
+
+            //The cells around the broken edges (the faces of their vertexs) and their neighbours are rebuilt
+            std::vector<char> isChanged(faces.size(), 0);
+            std::vector<size_t> changed, neighbours;
+            auto addChanged = [&](size_t face) {
+                if(face != null && !isChanged[face]) {
+                    isChanged[face] = 1;
+                    changed.push_back(face);
+                }
+            };
+            for(size_t pair = 0; pair < broken.size(); pair++) {
+                if(!broken[pair])
+                    continue;
+                kineticStatistics.brokenEdges++;
+                for(size_t e = 2*pair; e < 2*pair + 2; e++) {
+                    addChanged(edges[e].getFaceID());
+                    if(edges[e].getPrevID() != null)
+                        addChanged(edges[dcel.getTwinID(edges[e].getPrevID())].getFaceID());
+                }
+            }
+            const size_t nBroken = changed.size();
+            for(size_t i = 0; i < nBroken; i++) {
+                findNeighbours(dcel, changed[i], neighbours);
+                for(size_t neighbour : neighbours)
+                    addChanged(neighbour);
+            }
+
+            //A region that turns out too small (sites that moved past their neighbours) computes the whole diagram again.
+            //The separated sites are then inserted, unless the recomputation already gave them their cells
+            if(changed.size() + separated.size() <= KINETIC_REBUILD_RATIO*nCells) {
+                kineticStatistics.recomputed = !changed.empty() && !rebuildCells(dcel, boundingBox, changed, std::vector<size_t>());
+                kineticStatistics.rebuiltCells = kineticStatistics.recomputed ? nCells : changed.size();
+                for(size_t face : separated) {
+                    if(faces[face].getIncidEdgeID() == null && !internal::hasCoincidentCell(dcel, face))
+                        insertFace(face, dcel, boundingBox, dcel.getCoincidentFace(face));
+                }
+                if(statistics != nullptr)
+                    *statistics = kineticStatistics;
+                return;
+            }
+        }
+
+        recomputeCells(dcel, boundingBox, separated, std::vector<size_t>());
+        kineticStatistics.rebuiltCells = nCells;
+        kineticStatistics.recomputed = true;
+        if(statistics != nullptr)
+            *statistics = kineticStatistics;
+    }
+
+}
@@ -0,0 +1,25 @@
+#ifndef KINETIC_H
+#define KINETIC_H
+
+#include "cellrebuild.h"
+
+namespace Voronoi {
+    /**
+     * @brief The KineticStatistics struct, counters of the work done by a call of moveSites.
+     * brokenEdges counts the pairs of halfEdges whose orientation or empty circle was not valid anymore after the motion,
+     * separatedSites the faces without a cell whose site moved apart from the one of the cell of their ring
+     */
+    struct KineticStatistics {
+        size_t brokenEdges;
+        size_t separatedSites;
+        size_t rebuiltCells;
+        bool recomputed;
+
+        KineticStatistics() : brokenEdges(0), separatedSites(0), rebuiltCells(0), recomputed(false) {}
+    };
+
+    void moveSites(const std::vector<cg3::Point2Dd>& sites, DCEL& dcel, const cg3::BoundingBox2D& boundingBox,
+                   KineticStatistics* statistics = nullptr);
+}
+
+#endif // KINETIC_H
@@ -0,0 +1,440 @@
+#include "parallelfortune.h"
+
+#include "voronoidiagram.h"
+#include "incremental.h"
+
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+//Under this number of sites the sequential sweep is used
+#define PARALLEL_FORTUNE_MIN_SIZE 20000
+//Initial width of the band of sites shared with the adjacent strips, in average distances between the sites
+#define PARALLEL_FORTUNE_MARGIN 4.0
+//Over this number of sites missing from the diagram of a strip, the strip is swept again instead of inserting them
+#define PARALLEL_FORTUNE_MAX_INSERTIONS 64
+
+namespace Voronoi {
+
+    namespace internal {
+
+        /**
+         * @brief The SiteGrid struct, a uniform grid on the box with the sites in each of its cells
+         */
+        struct SiteGrid {
+            double minX, minY, cellSize;
+            size_t columns, rows;
+            std::vector<size_t> cellStarts, sites;
+
+            size_t column(double x) const {
+                return static_cast<size_t>(std::min(std::max((x - minX)/cellSize, 0.0), static_cast<double>(columns - 1)));
+            }
+
+            size_t row(double y) const {
+                return static_cast<size_t>(std::min(std::max((y - minY)/cellSize, 0.0), static_cast<double>(rows - 1)));
+            }
+        };
+
+        void buildSiteGrid(SiteGrid& grid, const std::vector<cg3::Point2Dd>& points, const cg3::BoundingBox2D& boundingBox, double cellSize) {
+            grid.minX = boundingBox.min().x();
+            grid.minY = boundingBox.min().y();
+            grid.cellSize = cellSize;
+            grid.columns = static_cast<size_t>((boundingBox.max().x() - grid.minX)/cellSize) + 1;
+            grid.rows = static_cast<size_t>((boundingBox.max().y() - grid.minY)/cellSize) + 1;
+            grid.cellStarts.assign(grid.columns*grid.rows + 1, 0);
+            grid.sites.resize(points.size());
+            std::vector<size_t> cells(points.size());
+            for(size_t i = 0; i < points.size(); i++) {
+                cells[i] = grid.row(points[i].y())*grid.columns + grid.column(points[i].x());
+                grid.cellStarts[cells[i] + 1]++;
+            }
+            for(size_t c = 0; c < grid.columns*grid.rows; c++)
+                grid.cellStarts[c + 1] += grid.cellStarts[c];
+            std::vector<size_t> next(grid.cellStarts.begin(), grid.cellStarts.end() - 1);
+            for(size_t i = 0; i < points.size(); i++)
+                grid.sites[next[cells[i]]++] = i;
+        }
+
+        /**
+         * @brief The Strip struct, a vertical strip of the sites with the diagram of them and of the sites around the strip.
+         * Local elements are the ones of the diagram of the strip, global ones the ones of the result
+         */
+        struct Strip {
+            //the sites of the strip, and the band of sites swept with them, as positions in the x order
+            size_t begin, end, bandBegin, bandEnd;
+            DCEL dcel;
+            //the site of each local face: the band, then the sites inserted to certify the cells
+            std::vector<size_t> localSites;
+
+            //global halfEdges and vertexs of the local ones used by the cells of the strip
+            std::vector<size_t> halfEdgeIDs, vertexIDs;
+            //local halfEdges (the first of each global pair) and vertexs created by the strip
+            std::vector<size_t> pairs, vertexs, vertexIncidEdges;
+            //halfEdges outside the box
+            std::vector<size_t> outerEdges;
+            //elements shared with other strips: created by this strip, and created by another one
+            std::vector<std::pair<std::pair<size_t, size_t>, size_t>> sharedEdges, foreignEdges;
+            std::vector<std::pair<VertexKey, size_t>> sharedVertexs, foreignVertexs;
+            size_t firstPair, firstVertex;
+        };
+
+        /**
+         * @brief sweepStrip computes the diagram of the sites of the strip and of the ones within margin from it.
+         * A cell of the strip is certified when no site left out is nearer to one of its vertexs than the site of the cell,
+         * so the cell is the same of the whole diagram: the sites left out that break this (usually around the cells
+         * touching the box) are inserted in the diagram of the strip, until all the cells are certified
+         */
+        void sweepStrip(Strip& strip, const std::vector<cg3::Point2Dd>& points, const std::vector<size_t>& order,
+                        const std::vector<size_t>& position, const SiteGrid& grid, const cg3::BoundingBox2D& boundingBox, double margin) {
+            const size_t n = order.size();
+            auto positionOf = [&](double x) {
+                return static_cast<size_t>(std::lower_bound(order.begin(), order.end(), x, [&points](size_t p, double value) {
+                    return points[p].x() < value;
+                }) - order.begin());
+            };
+
+            strip.bandBegin = positionOf(points[order[strip.begin]].x() - margin);
+            strip.bandEnd = positionOf(std::nextafter(points[order[strip.end-1]].x() + margin, std::numeric_limits<double>::max()));
+            strip.localSites.assign(order.begin() + static_cast<long>(strip.bandBegin), order.begin() + static_cast<long>(strip.bandEnd));
+            std::vector<cg3::Point2Dd> sites;
+            sites.reserve(strip.localSites.size());
+            for(size_t site : strip.localSites)
+                sites.push_back(points[site]);
+            fortuneAlgorithm(sites, strip.dcel, boundingBox);
+
+            //Cells of the strip whose circles reach beyond the band
+            const double leftLimit = strip.bandBegin > 0 ? points[order[strip.bandBegin-1]].x() : -std::numeric_limits<double>::max();
+            const double rightLimit = strip.bandEnd < n ? points[order[strip.bandEnd]].x() : std::numeric_limits<double>::max();
+            std::vector<size_t> uncertified;
+            for(size_t f = strip.begin - strip.bandBegin; f < strip.end - strip.bandBegin; f++) {
+                const std::vector<HalfEdge>& edges = strip.dcel.getHalfEdges();
+                size_t start = strip.dcel.getFaces()[f].getIncidEdgeID(), e = start;
+                if(start == std::numeric_limits<size_t>::max())
+                    continue;
+                do {
+                    cg3::Point2Dd v = strip.dcel.getVertexCoordinates(edges[e].getOriginID());
+                    double radius = v.dist(points[strip.localSites[f]]);
+                    if(!(v.x() - radius > leftLimit && v.x() + radius < rightLimit)) {
+                        uncertified.push_back(f);
+                        break;
+                    }
+                    e = edges[e].getNextID();
+                } while(e != start);
+            }
+
+            std::unordered_set<size_t> inserted;
+            std::vector<size_t> missing;
+            std::vector<std::pair<cg3::Point2Dd, double>> circles;
+            while(!uncertified.empty()) {
+                missing.clear();
+                for(size_t f : uncertified) {
+                    //The circles of the vertexs of the cell, the grid is scanned once on their bounding rectangle
+                    const std::vector<HalfEdge>& edges = strip.dcel.getHalfEdges();
+                    size_t start = strip.dcel.getFaces()[f].getIncidEdgeID(), e = start;
+                    circles.clear();
+                    double minX = std::numeric_limits<double>::max(), maxX = -minX, minY = minX, maxY = -minX;
+                    do {
+                        cg3::Point2Dd v = strip.dcel.getVertexCoordinates(edges[e].getOriginID());
+                        double radius = v.dist(points[strip.localSites[f]]);
+                        circles.push_back(std::make_pair(v, radius));
+                        minX = std::min(minX, v.x() - radius);
+                        maxX = std::max(maxX, v.x() + radius);
+                        minY = std::min(minY, v.y() - radius);
+                        maxY = std::max(maxY, v.y() + radius);
+                        e = edges[e].getNextID();
+                    } while(e != start);
+
+                    for(size_t r = grid.row(minY); r <= grid.row(maxY); r++) {
+                        for(size_t c = grid.column(minX); c <= grid.column(maxX); c++) {
+                            for(size_t i = grid.cellStarts[r*grid.columns + c]; i < grid.cellStarts[r*grid.columns + c + 1]; i++) {
+                                size_t site = grid.sites[i];
+                                if(position[site] >= strip.bandBegin && position[site] < strip.bandEnd)
+                                    continue;
+                                for(const std::pair<cg3::Point2Dd, double>& circle : circles) {
+                                    if(points[site].dist(circle.first) < circle.second) {
+                                        if(inserted.insert(site).second)
+                                            missing.push_back(site);
+                                        break;
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+                if(missing.empty())
+                    return;
+
+                //A few sites are inserted, many ones are swept again with the others
+                strip.localSites.insert(strip.localSites.end(), missing.begin(), missing.end());
+                if(missing.size() <= PARALLEL_FORTUNE_MAX_INSERTIONS) {
+                    size_t hint = std::numeric_limits<size_t>::max();
+                    for(size_t site : missing)
+                        hint = insertSite(points[site], strip.dcel, boundingBox, hint);
+                } else {
+                    for(size_t site : missing)
+                        sites.push_back(points[site]);
+                    strip.dcel.clear();
+                    fortuneAlgorithm(sites, strip.dcel, boundingBox);
+                }
+            }
+        }
+
+    }
+
+    /**
+     * @brief fortuneAlgorithmParallel computes the same diagram of fortuneAlgorithm using nThreads threads.
+     * The sites are split by x-coordinate into a strip for each thread; each strip is swept by its own thread
+     * (fortuneAlgorithm on the sites of the strip and on a band of sites around it, wide enough to give the exact cells
+     * of the sites of the strip), then the cells of all the strips are stitched in a single DCEL: the elements inside
+     * a strip are copied, the halfEdges and vertexs on the seams between strips are matched by their faces.
+     * The faces are in the same order of points, as in fortuneAlgorithm
+     * @param points: the sites of the diagram
+     * @param dcel: the DCEL where the diagram is stored
+     * @param boundingBox: the box used to clip the diagram
+     * @param nThreads: the number of threads, 0 to use the OpenMP default
+     */
+    void fortuneAlgorithmParallel(const std::vector<cg3::Point2Dd>& points, DCEL& dcel,
+                                  const cg3::BoundingBox2D& boundingBox, int nThreads) {
+        const size_t n = points.size();
+        const size_t null = std::numeric_limits<size_t>::max();
+        #ifdef _OPENMP
+        if(nThreads <= 0)
+            nThreads = omp_get_max_threads();
+        #else
+        nThreads = 1;
+        #endif
+        bool isInside = true;
+        for(size_t i = 0; i < n && isInside; i++)
+            isInside = boundingBox.isInside(points[i]);
+        //The cells of the sites outside the box are not local enough to be certified
+        if(nThreads <= 1 || n < PARALLEL_FORTUNE_MIN_SIZE || !isInside) {
+            fortuneAlgorithm(points, dcel, boundingBox);
+            return;
+        }
+
+        std::vector<size_t> order, position(n);
+        sortSitesByX(points, order);
+        for(size_t i = 0; i < n; i++)
+            position[order[i]] = i;
+
+        const size_t nStrips = static_cast<size_t>(nThreads);
+        std::vector<internal::Strip> strips(nStrips);
+        for(size_t s = 0; s < nStrips; s++) {
+            strips[s].begin = n*s/nStrips;
+            strips[s].end = n*(s+1)/nStrips;
+        }
+        auto stripOf = [&](size_t point) {
+            size_t p = position[point], s = p*nStrips/n;
+            while(strips[s].end <= p)
+                s++;
+            while(strips[s].begin > p)
+                s--;
+            return s;
+        };
+        const double area = (boundingBox.max().x() - boundingBox.min().x())*(boundingBox.max().y() - boundingBox.min().y());
+        const double spacing = std::sqrt(area/n), margin = PARALLEL_FORTUNE_MARGIN*spacing;
+        internal::SiteGrid grid;
+        internal::buildSiteGrid(grid, points, boundingBox, 2*spacing);
+
+        dcel.fitOrigin(boundingBox);
+        const size_t firstFace = dcel.getFaces().size();
+        const size_t firstHalfEdge = dcel.getHalfEdges().size(), firstVertex = dcel.getVertexs().size();
+        const long long nStripsSigned = static_cast<long long>(nStrips);
+
+        //Sweep of the strips, and the elements each strip creates or takes from another one
+        #pragma omp parallel for schedule(dynamic, 1) num_threads(nThreads)
+        for(long long s = 0; s < nStripsSigned; s++) {
+            internal::Strip& strip = strips[s];
+            internal::sweepStrip(strip, points, order, position, grid, boundingBox, margin);
+
+            const DCEL& local = strip.dcel;
+            const std::vector<HalfEdge>& edges = local.getHalfEdges();
+            auto globalTag = [&](size_t tag) {
+                return internal::isBoxSideTag(tag) ? tag : strip.localSites[tag];
+            };
+            auto isOwn = [&](size_t localFace) {
+                return localFace != null && position[strip.localSites[localFace]] >= strip.begin && position[strip.localSites[localFace]] < strip.end;
+            };
+
+            strip.halfEdgeIDs.assign(edges.size(), null);
+            strip.vertexIDs.assign(local.getVertexs().size(), null);
+            std::vector<char> isVisited(local.getVertexs().size(), 0);
+            for(size_t f = strip.begin - strip.bandBegin; f < strip.end - strip.bandBegin; f++) {
+                size_t start = local.getFaces()[f].getIncidEdgeID(), e = start;
+                if(start == null)
+                    continue;
+                do {
+                    size_t twin = local.getTwinID(e), twinFace = edges[twin].getFaceID();
+                    if(twinFace == null) {
+                        strip.pairs.push_back(e);
+                        strip.outerEdges.push_back(twin);
+                    } else if(isOwn(twinFace)) {
+                        if(e < twin)
+                            strip.pairs.push_back(e);
+                    } else {
+                        std::pair<size_t, size_t> key(strip.localSites[f], strip.localSites[twinFace]);
+                        if(stripOf(key.second) > static_cast<size_t>(s)) {
+                            strip.pairs.push_back(e);
+                            strip.sharedEdges.push_back(std::make_pair(std::make_pair(key.second, key.first), e));
+                        } else
+                            strip.foreignEdges.push_back(std::make_pair(key, e));
+                    }
+
+                    size_t v = edges[e].getOriginID();
+                    if(!isVisited[v]) {
+                        isVisited[v] = 1;
+                        //Only the vertexs touching the cells of other strips need their key
+                        size_t around[2] = {twinFace, edges[local.getTwinID(edges[e].getPrevID())].getFaceID()};
+                        bool isShared = (around[0] != null && !isOwn(around[0])) || (around[1] != null && !isOwn(around[1]));
+                        size_t owner = static_cast<size_t>(s);
+                        internal::VertexKey key;
+                        if(isShared) {
+                            key = internal::vertexKey(globalTag(f),
+                                                      globalTag(internal::edgeTag(local, edges[e].getPrevID(), boundingBox)),
+                                                      globalTag(internal::edgeTag(local, e, boundingBox)));
+                            for(size_t tag : key) {
+                                if(tag != null && !internal::isBoxSideTag(tag))
+                                    owner = std::min(owner, stripOf(tag));
+                            }
+                        }
+                        if(owner == static_cast<size_t>(s)) {
+                            strip.vertexs.push_back(v);
+                            strip.vertexIncidEdges.push_back(e);
+                            if(isShared)
+                                strip.sharedVertexs.push_back(std::make_pair(key, v));
+                        } else
+                            strip.foreignVertexs.push_back(std::make_pair(key, v));
+                    }
+                    e = edges[e].getNextID();
+                } while(e != start);
+            }
+        }
+
+        //Global indices of the elements created by each strip
+        size_t nPairs = 0, nVertexs = 0;
+        for(internal::Strip& strip : strips) {
+            strip.firstPair = nPairs;
+            strip.firstVertex = nVertexs;
+            nPairs += strip.pairs.size();
+            nVertexs += strip.vertexs.size();
+        }
+        dcel.getFaces().resize(firstFace + n);
+        dcel.getHalfEdges().resize(firstHalfEdge + 2*nPairs);
+        dcel.getVertexs().resize(firstVertex + nVertexs);
+        #pragma omp parallel for num_threads(nThreads)
+        for(long long i = 0; i < static_cast<long long>(n); i++)
+            dcel.getFaces()[firstFace + i] = Face(points[i]);
+
+        #pragma omp parallel for schedule(dynamic, 1) num_threads(nThreads)
+        for(long long s = 0; s < nStripsSigned; s++) {
+            internal::Strip& strip = strips[s];
+            const std::vector<HalfEdge>& edges = strip.dcel.getHalfEdges();
+            for(size_t i = 0; i < strip.pairs.size(); i++) {
+                size_t e = strip.pairs[i], twin = strip.dcel.getTwinID(e), global = firstHalfEdge + 2*(strip.firstPair + i);
+                strip.halfEdgeIDs[e] = global;
+                size_t twinFace = edges[twin].getFaceID();
+                if(twinFace == null || (position[strip.localSites[twinFace]] >= strip.begin && position[strip.localSites[twinFace]] < strip.end))
+                    strip.halfEdgeIDs[twin] = global + 1;
+            }
+            for(size_t i = 0; i < strip.vertexs.size(); i++)
+                strip.vertexIDs[strip.vertexs[i]] = firstVertex + strip.firstVertex + i;
+            for(std::pair<std::pair<size_t, size_t>, size_t>& shared : strip.sharedEdges)
+                shared.second = strip.halfEdgeIDs[shared.second] + 1;
+            for(std::pair<internal::VertexKey, size_t>& shared : strip.sharedVertexs)
+                shared.second = strip.vertexIDs[shared.second];
+        }
+
+        //Seams: the elements shared by two strips are matched by their faces
+        std::unordered_map<std::pair<size_t, size_t>, size_t, internal::PairHash> sharedEdges;
+        std::map<internal::VertexKey, size_t> sharedVertexs;
+        for(const internal::Strip& strip : strips) {
+            sharedEdges.insert(strip.sharedEdges.begin(), strip.sharedEdges.end());
+            sharedVertexs.insert(strip.sharedVertexs.begin(), strip.sharedVertexs.end());
+        }
+        bool isStitched = true;
+        for(internal::Strip& strip : strips) {
+            for(const std::pair<std::pair<size_t, size_t>, size_t>& foreign : strip.foreignEdges) {
+                std::unordered_map<std::pair<size_t, size_t>, size_t, internal::PairHash>::const_iterator it = sharedEdges.find(foreign.first);
+                if(it == sharedEdges.end())
+                    isStitched = false;
+                else
+                    strip.halfEdgeIDs[foreign.second] = it->second;
+            }
+            for(const std::pair<internal::VertexKey, size_t>& foreign : strip.foreignVertexs) {
+                std::map<internal::VertexKey, size_t>::const_iterator it = sharedVertexs.find(foreign.first);
+                if(it == sharedVertexs.end())
+                    isStitched = false;
+                else
+                    strip.vertexIDs[foreign.second] = it->second;
+            }
+        }
+        //The strips disagree on a seam only with degenerate sites (e.g. four cocircular sites across it)
+        if(!isStitched) {
+            dcel.getFaces().resize(firstFace);
+            dcel.getHalfEdges().resize(firstHalfEdge);
+            dcel.getVertexs().resize(firstVertex);
+            fortuneAlgorithm(points, dcel, boundingBox);
+            return;
+        }
+
+        //Copy of the cells
+        std::vector<HalfEdge>& globalEdges = dcel.getHalfEdges();
+        std::vector<Vertex>& globalVertexs = dcel.getVertexs();
+        std::vector<Face>& globalFaces = dcel.getFaces();
+        #pragma omp parallel for schedule(dynamic, 1) num_threads(nThreads)
+        for(long long s = 0; s < nStripsSigned; s++) {
+            const internal::Strip& strip = strips[s];
+            const DCEL& local = strip.dcel;
+            const std::vector<HalfEdge>& edges = local.getHalfEdges();
+            for(size_t f = strip.begin - strip.bandBegin; f < strip.end - strip.bandBegin; f++) {
+                size_t start = local.getFaces()[f].getIncidEdgeID(), e = start;
+                if(start == null)
+                    continue;
+                size_t face = firstFace + strip.localSites[f];
+                globalFaces[face].setIncidEdge(strip.halfEdgeIDs[start]);
+                do {
+                    HalfEdge& halfEdge = globalEdges[strip.halfEdgeIDs[e]];
+                    halfEdge.setOrigin(strip.vertexIDs[edges[e].getOriginID()]);
+                    halfEdge.setNext(strip.halfEdgeIDs[edges[e].getNextID()]);
+                    halfEdge.setPrev(strip.halfEdgeIDs[edges[e].getPrevID()]);
+                    halfEdge.setFace(face);
+                    #ifndef VORONOI_COMPACT_DCEL
+                    halfEdge.setTwin(strip.halfEdgeIDs[e] ^ 1);
+                    #endif
+                    e = edges[e].getNextID();
+                } while(e != start);
+            }
+            for(size_t outer : strip.outerEdges) {
+                HalfEdge& halfEdge = globalEdges[strip.halfEdgeIDs[outer]];
+                halfEdge.setOrigin(strip.vertexIDs[edges[outer].getOriginID()]);
+                halfEdge.setFace(null);
+                #ifndef VORONOI_COMPACT_DCEL
+                halfEdge.setTwin(strip.halfEdgeIDs[outer] ^ 1);
+                #endif
+            }
+            for(size_t i = 0; i < strip.vertexs.size(); i++) {
+                globalVertexs[firstVertex + strip.firstVertex + i] = dcel.makeVertex(local.getVertexCoordinates(strip.vertexs[i]),
+                                                                                     strip.halfEdgeIDs[strip.vertexIncidEdges[i]]);
+            }
+        }
+
+        //The halfEdges outside the box form a single clockwise cycle: each one is followed by the one leaving its end
+        std::unordered_map<size_t, size_t> outerLeaving;
+        for(const internal::Strip& strip : strips) {
+            for(size_t outer : strip.outerEdges)
+                outerLeaving[globalEdges[strip.halfEdgeIDs[outer]].getOriginID()] = strip.halfEdgeIDs[outer];
+        }
+        for(const std::pair<const size_t, size_t>& outer : outerLeaving) {
+            std::unordered_map<size_t, size_t>::const_iterator next = outerLeaving.find(globalEdges[dcel.getTwinID(outer.second)].getOriginID());
+            if(next != outerLeaving.end()) {
+                globalEdges[outer.second].setNext(next->second);
+                globalEdges[next->second].setPrev(outer.second);
+            }
+        }
+    }
+
+}
@@ -0,0 +1,14 @@
+#ifndef PARALLELFORTUNE_H
+#define PARALLELFORTUNE_H
+
+#include "../data_structures/dcel.h"
+#include <cg3/geometry/2d/bounding_box2d.h>
+
+namespace Voronoi {
+
+    void fortuneAlgorithmParallel(const std::vector<cg3::Point2Dd>& points, DCEL& dcel,
+                                  const cg3::BoundingBox2D& boundingBox, int nThreads = 0);
+
+}
+
+#endif // PARALLELFORTUNE_H
@@ -0,0 +1,198 @@
+#include "radixsort.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdint.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#define RADIX_BITS 11
+#define RADIX_BUCKETS (1 << RADIX_BITS)
+#define RADIX_PASSES ((64 + RADIX_BITS - 1) / RADIX_BITS)
+//Under this size a comparison sort is faster than the radix passes
+#define RADIX_MIN_SIZE 1024
+//Under this size a single thread is used
+#define RADIX_PARALLEL_MIN_SIZE 65536
+
+namespace Voronoi {
+
+    namespace internal {
+
+        /**
+         * @brief sortKey maps y to an unsigned integer such that greater y gives smaller keys
+         * @param y
+         * @return the key of y
+         */
+        inline uint64_t sortKey(double y) {
+            uint64_t bits;
+            //-0.0 and +0.0 must have the same key
+            if(y == 0.0)
+                y = 0.0;
+            std::memcpy(&bits, &y, sizeof(double));
+            //Order preserving transformation of the IEEE 754 representation, then flipped for descending order
+            bits = (bits & 0x8000000000000000ULL) ? ~bits : (bits | 0x8000000000000000ULL);
+            return ~bits;
+        }
+
+        /**
+         * @brief radixPass stable scatter of keys and indices by the digit starting at bit shift
+         * @return false if all the keys have the same digit, so nothing has been moved
+         */
+        bool radixPass(const std::vector<uint64_t>& keys, const std::vector<size_t>& indices,
+                       std::vector<uint64_t>& keysOut, std::vector<size_t>& indicesOut,
+                       unsigned int shift, std::vector<size_t>& histograms, int nThreads) {
+            const size_t n = keys.size();
+            std::fill(histograms.begin(), histograms.end(), 0);
+
+            #pragma omp parallel num_threads(nThreads) if(nThreads > 1)
+            {
+                int t = 0;
+                #ifdef _OPENMP
+                t = omp_get_thread_num();
+                #endif
+                size_t begin = n*t/nThreads, end = n*(t+1)/nThreads;
+                size_t* histogram = &histograms[t*RADIX_BUCKETS];
+                for(size_t i = begin; i < end; i++)
+                    histogram[(keys[i] >> shift) & (RADIX_BUCKETS-1)]++;
+            }
+
+            //If a single bucket holds all the keys the pass is skipped
+            for(size_t b = 0; b < RADIX_BUCKETS; b++) {
+                size_t count = 0;
+                for(int t = 0; t < nThreads; t++)
+                    count += histograms[t*RADIX_BUCKETS + b];
+                if(count == n)
+                    return false;
+                if(count > 0)
+                    break;
+            }
+
+            //Exclusive prefix sums, bucket-major and thread-minor to keep the sort stable
+            size_t offset = 0;
+            for(size_t b = 0; b < RADIX_BUCKETS; b++) {
+                for(int t = 0; t < nThreads; t++) {
+                    size_t count = histograms[t*RADIX_BUCKETS + b];
+                    histograms[t*RADIX_BUCKETS + b] = offset;
+                    offset += count;
+                }
+            }
+
+            #pragma omp parallel num_threads(nThreads) if(nThreads > 1)
+            {
+                int t = 0;
+                #ifdef _OPENMP
+                t = omp_get_thread_num();
+                #endif
+                size_t begin = n*t/nThreads, end = n*(t+1)/nThreads;
+                size_t* histogram = &histograms[t*RADIX_BUCKETS];
+                for(size_t i = begin; i < end; i++) {
+                    size_t position = histogram[(keys[i] >> shift) & (RADIX_BUCKETS-1)]++;
+                    keysOut[position] = keys[i];
+                    indicesOut[position] = indices[i];
+                }
+            }
+            return true;
+        }
+
+        /**
+         * @brief radixSortSites sorts the indices of points by the keys given by key, with a parallel LSD radix sort,
+         * followed by a fix with before of the (usually short) runs of equal keys
+         */
+        template<class Key, class Before>
+        void radixSortSites(const SiteSpan& points, std::vector<size_t>& order,
+                            RadixSortBuffers& buffers, Key key, Before before) {
+            const size_t n = points.size();
+            order.resize(n);
+            for(size_t i = 0; i < n; i++)
+                order[i] = i;
+
+            if(n < RADIX_MIN_SIZE) {
+                std::sort(order.begin(), order.end(), before);
+                return;
+            }
+
+            //The passes split the work among the threads by hand, so they cannot run inside another parallel region
+            int nThreads = 1;
+            #ifdef _OPENMP
+            if(n >= RADIX_PARALLEL_MIN_SIZE && !omp_in_parallel())
+                nThreads = omp_get_max_threads();
+            #endif
+
+            std::vector<uint64_t>& keys = buffers.keys;
+            std::vector<uint64_t>& keysTmp = buffers.keysTmp;
+            std::vector<size_t>& indicesTmp = buffers.indicesTmp;
+            std::vector<size_t>& histograms = buffers.histograms;
+            keys.resize(n);
+            keysTmp.resize(n);
+            indicesTmp.resize(n);
+            histograms.resize(static_cast<size_t>(nThreads)*RADIX_BUCKETS);
+
+            #pragma omp parallel for num_threads(nThreads) if(nThreads > 1)
+            for(long long i = 0; i < static_cast<long long>(n); i++)
+                keys[i] = key(static_cast<size_t>(i));
+
+            for(unsigned int pass = 0; pass < RADIX_PASSES; pass++) {
+                if(radixPass(keys, order, keysTmp, indicesTmp, pass*RADIX_BITS, histograms, nThreads)) {
+                    keys.swap(keysTmp);
+                    order.swap(indicesTmp);
+                }
+            }
+
+            size_t begin = 0;
+            while(begin < n) {
+                size_t end = begin+1;
+                while(end < n && keys[end] == keys[begin])
+                    end++;
+                if(end - begin > 1)
+                    std::sort(order.begin()+begin, order.begin()+end, before);
+                begin = end;
+            }
+        }
+
+    }
+
+    /**
+     * @brief sortSitesByY computes the order in which the sweepline meets the sites: decreasing y-coordinate,
+     * and increasing x-coordinate for sites with the same y-coordinate.
+     * It uses a parallel LSD radix sort on the y-coordinates, followed by a fix of the (usually short) runs of equal y
+     * @param points: the sites
+     * @param order: output, the indices of the sites in sweep order
+     */
+    void sortSitesByY(const SiteSpan& points, std::vector<size_t>& order) {
+        RadixSortBuffers buffers;
+        sortSitesByY(points, order, buffers);
+    }
+
+    /**
+     * @brief sortSitesByY computes the order in which the sweepline meets the sites, as sortSitesByY,
+     * with the keys and the histograms of the passes in buffers
+     * @param points: the sites
+     * @param order: output, the indices of the sites in sweep order
+     * @param buffers: resized as needed, their memory is kept for the next sorts
+     */
+    void sortSitesByY(const SiteSpan& points, std::vector<size_t>& order, RadixSortBuffers& buffers) {
+        internal::radixSortSites(points, order, buffers, [&points](size_t i) {
+            return internal::sortKey(points.y(i));
+        }, [&points](size_t a, size_t b) {
+            return points.y(a) > points.y(b) || (points.y(a) == points.y(b) && points.x(a) < points.x(b));
+        });
+    }
+
+    /**
+     * @brief sortSitesByX sorts the sites by increasing x-coordinate, and increasing y-coordinate for sites
+     * with the same x-coordinate, with the same radix sort of sortSitesByY
+     * @param points: the sites
+     * @param order: output, the indices of the sites in order
+     */
+    void sortSitesByX(const SiteSpan& points, std::vector<size_t>& order) {
+        RadixSortBuffers buffers;
+        internal::radixSortSites(points, order, buffers, [&points](size_t i) {
+            return ~internal::sortKey(points.x(i));
+        }, [&points](size_t a, size_t b) {
+            return points.x(a) < points.x(b) || (points.x(a) == points.x(b) && points.y(a) < points.y(b));
+        });
+    }
+
+}
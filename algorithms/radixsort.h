@@ -0,0 +1,24 @@
+#ifndef RADIXSORT_H
+#define RADIXSORT_H
+
+#include <vector>
+#include <stdint.h>
+#include "../data_structures/sitespan.h"
+
+namespace Voronoi {
+    /**
+     * @brief The RadixSortBuffers struct, the keys, the indices and the histograms of the passes of the radix sort.
+     * Reused for many sorts, they allocate only for a larger number of sites
+     */
+    struct RadixSortBuffers {
+        std::vector<uint64_t> keys, keysTmp;
+        std::vector<size_t> indicesTmp, histograms;
+    };
+
+    void sortSitesByY(const SiteSpan& points, std::vector<size_t>& order);
+    void sortSitesByY(const SiteSpan& points, std::vector<size_t>& order, RadixSortBuffers& buffers);
+    void sortSitesByX(const SiteSpan& points, std::vector<size_t>& order);
+
+}
+
+#endif // RADIXSORT_H
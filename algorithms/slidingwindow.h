@@ -0,0 +1,79 @@
+#ifndef SLIDINGWINDOW_H
+#define SLIDINGWINDOW_H
+
+#include <deque>
+
+#include "../data_structures/dcel.h"
+#include <cg3/geometry/2d/bounding_box2d.h>
+
+namespace Voronoi {
+
+    /**
+     * @brief The SlidingWindowStatistics struct, counters of the work done by a SlidingWindowDiagram
+     */
+    struct SlidingWindowStatistics {
+        size_t ticks;
+        size_t insertedSites;
+        size_t expiredSites;
+        //sites outside the box, or already expired when their tick came
+        size_t rejectedSites;
+        //ticks that computed the whole diagram instead of updating it
+        size_t recomputations;
+
+        SlidingWindowStatistics() : ticks(0), insertedSites(0), expiredSites(0), rejectedSites(0), recomputations(0) {}
+    };
+
+    /**
+     * @brief The SlidingWindowDiagram class keeps the Voronoi diagram of the points of a stream arrived in the last
+     * window seconds. The points pushed between two ticks are inserted in the diagram at the next tick, together with
+     * the removal of the expired ones, as local updates of the DCEL (insertSite and removeSite).
+     * When a tick changes too many sites the diagram is computed again from the sites in the window: a tick never costs
+     * much more than a full computation of the diagram. The faces of the expired sites are reused by the new ones.
+     * Equal sites in the window are in a ring of coincident faces (DCEL::getCoincidentFace) and share one cell: when the
+     * copy holding it expires, the cell passes to a copy still in the window.
+     * Timestamps are expected non-decreasing, the sites expire in the order they arrived
+     * @class SlidingWindowDiagram
+     */
+    class SlidingWindowDiagram {
+        public:
+            SlidingWindowDiagram(const cg3::BoundingBox2D& boundingBox, double window);
+
+            void push(const cg3::Point2Dd& p, double timestamp);
+            void tick(double now);
+            void clear();
+
+            const DCEL& getDCEL() const;
+            size_t size() const;
+            const SlidingWindowStatistics& getStatistics() const;
+
+        private:
+            struct TimedSite {
+                cg3::Point2Dd site;
+                double timestamp;
+                size_t face;
+            };
+
+            DCEL dcel;
+            cg3::BoundingBox2D boundingBox;
+            double window;
+            std::deque<TimedSite> sites;
+            std::vector<TimedSite> arrivals;
+            SlidingWindowStatistics statistics;
+
+            void recompute();
+    };
+
+    inline const DCEL& SlidingWindowDiagram::getDCEL() const {
+        return dcel;
+    }
+
+    inline size_t SlidingWindowDiagram::size() const {
+        return sites.size();
+    }
+
+    inline const SlidingWindowStatistics& SlidingWindowDiagram::getStatistics() const {
+        return statistics;
+    }
+}
+
+#endif // SLIDINGWINDOW_H
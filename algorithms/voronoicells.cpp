@@ -0,0 +1,72 @@
+#include "voronoicells.h"
+
+namespace Voronoi {
+
+    /**
+     * @brief computeCells extracts the polygons of all the faces of dcel, with their areas and centroids,
+     * in a single walk of the boundary of each face
+     * @param dcel
+     * @param cells: the output, its previous content is replaced
+     */
+    void computeCells(const DCEL& dcel, VoronoiCells& cells) {
+        const std::vector<Face>& faces = dcel.getFaces();
+        const std::vector<HalfEdge>& edges = dcel.getHalfEdges();
+        const size_t null = std::numeric_limits<size_t>::max();
+
+        cells.clear();
+        cells.vertices.reserve(edges.size());
+        cells.offsets.reserve(faces.size() + 1);
+        cells.areas.reserve(faces.size());
+        cells.centroids.reserve(faces.size());
+
+        cells.offsets.push_back(0);
+        for(size_t f = 0; f < faces.size(); f++) {
+            size_t start = faces[f].getIncidEdgeID();
+
+            if(start != null) {
+                //If the boundary is not closed, the walk starts from its first halfEdge
+                size_t first = start, steps = 0;
+                while(edges[first].getPrevID() != null && edges[first].getPrevID() != start && steps++ < edges.size())
+                    first = edges[first].getPrevID();
+
+                size_t e = first, last = first;
+                steps = 0;
+                do {
+                    if(edges[e].getOriginID() != null)
+                        cells.vertices.push_back(dcel.getVertexCoordinates(edges[e].getOriginID()));
+                    last = e;
+                    e = edges[e].getNextID();
+                } while(e != null && e != first && steps++ < edges.size());
+
+                //The end of an open boundary is the destination of its last halfEdge
+                if(e == null && edges[dcel.getTwinID(last)].getOriginID() != null)
+                    cells.vertices.push_back(dcel.getVertexCoordinates(edges[dcel.getTwinID(last)].getOriginID()));
+            }
+
+            //Shoelace formula for area and centroid, computed relatively to the first vertex
+            size_t begin = cells.offsets.back(), end = cells.vertices.size();
+            double area = 0, cx = 0, cy = 0;
+            if(end - begin > 2) {
+                const cg3::Point2Dd& o = cells.vertices[begin];
+                for(size_t i = begin + 1; i + 1 < end; i++) {
+                    double x1 = cells.vertices[i].x() - o.x(), y1 = cells.vertices[i].y() - o.y();
+                    double x2 = cells.vertices[i+1].x() - o.x(), y2 = cells.vertices[i+1].y() - o.y();
+                    double cross = x1*y2 - x2*y1;
+                    area += cross;
+                    cx += (x1 + x2)*cross;
+                    cy += (y1 + y2)*cross;
+                }
+                area /= 2;
+            }
+
+            cells.offsets.push_back(end);
+            cells.areas.push_back(area);
+            if(area != 0)
+                cells.centroids.push_back(cg3::Point2Dd(cells.vertices[begin].x() + cx/(6*area),
+                                                        cells.vertices[begin].y() + cy/(6*area)));
+            else
+                cells.centroids.push_back(faces[f].getSite());
+        }
+    }
+
+}
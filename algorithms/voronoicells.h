@@ -0,0 +1,31 @@
+#ifndef VORONOICELLS_H
+#define VORONOICELLS_H
+
+#include "../data_structures/dcel.h"
+
+namespace Voronoi {
+    /**
+     * @brief The VoronoiCells struct, the cells of a diagram stored in contiguous arrays.
+     * The polygon of the face i is made of vertices[offsets[i]] ... vertices[offsets[i+1] - 1], counterclockwise.
+     * A cell that is not closed (an unbounded one, or one cut by the bounding box) is the chain of its finite vertices
+     */
+    struct VoronoiCells {
+        std::vector<cg3::Point2Dd> vertices;
+        std::vector<size_t> offsets;
+        std::vector<double> areas;
+        std::vector<cg3::Point2Dd> centroids;
+
+        void clear();
+    };
+
+    void computeCells(const DCEL& dcel, VoronoiCells& cells);
+
+    inline void VoronoiCells::clear() {
+        vertices.clear();
+        offsets.clear();
+        areas.clear();
+        centroids.clear();
+    }
+}
+
+#endif // VORONOICELLS_H
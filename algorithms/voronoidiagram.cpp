@@ -1,160 +1,222 @@
 #include "voronoidiagram.h"
 
+#include "delaunay.h"
+#include "halfplane.h"
+
+#include <algorithm>
+
+//Largest number of sites computed by halfPlaneAlgorithm instead of the sweep, from benchmark/EngineBenchmark.pro
+#define HALF_PLANE_MAX_SIZE 12
+
 namespace Voronoi {
 
-    void checkCircleEvent(const Leaf* l1, Leaf* middleArc, const Leaf* l3, const double& sweepline,
-                          std::priority_queue<Event*, std::vector<Event*>, EventComparator>& pq) {
+    /**
+     * @brief SweepWorkspace::reserve allocates the nodes, the events (one for each arc at most) and the order
+     * for a sweep of nSites sites, so that the first runs don't grow them step by step
+     * @param nSites
+     */
+    void SweepWorkspace::reserve(size_t nSites) {
+        beachline.reserve(nSites);
+        pq.reserve(2*nSites);
+        siteOrder.reserve(nSites);
+    }
 
-        //if newPoint->next->next or newPoint->prev->prev is null
-        if(!l3)
+    /**
+     * @brief checkCircleEvent schedules the circle event of middleArc, if its breakpoints converge.
+     * The convergence is decided by an exact orientation, without tolerances
+     * @param middleArc: the arc that could disappear, its neighbours are middleArc->prev and middleArc->next
+     * @param sites: the sites of the beachline
+     * @param sweepline
+     * @param pq: the queue of circle events
+     * @param statistics: the counter of rejected candidates is updated
+     */
+    void checkCircleEvent(Leaf* middleArc, const SiteSpan& sites, const double& sweepline, EventQueue& pq, SweepStatistics& statistics) {
+        //if the arc is the first or the last one of the beachline
+        if(!middleArc->prev || !middleArc->next)
             return;
 
+        const cg3::Point2Dd left = sites[middleArc->prev->site];
+        const cg3::Point2Dd middle = sites[middleArc->site];
+        const cg3::Point2Dd right = sites[middleArc->next->site];
+
+        if(!checkBreakpointsConvergence(left, middle, right)) {
+            statistics.rejectedCircleEvents++;
+            return;
+        }
+
         cg3::Point2Dd center, circleEventPoint;
 
-        if(!findCircleCenter(*(l1->site), *(middleArc->site), *(l3->site), center))
+        if(!findCircleCenter(left, middle, right, center))
             return;
 
-        circleEventPoint.set(center.x(), center.y() - center.dist(*(l1->site)));
-        if((circleEventPoint.y() - sweepline) < POINT_EPSILON || circleEventPoint.y() < sweepline) {
-            CircleEvent* e = new CircleEvent(circleEventPoint, center, middleArc);
-            middleArc->circleEvent = e;
-            pq.push(e);
+        //Converging breakpoints meet on or below the sweepline: an event above it is a rounding error of the center
+        circleEventPoint.set(center.x(), std::min(center.y() - center.dist(middle), sweepline));
+        middleArc->circleEvent = pq.push(circleEventPoint, center, middleArc);
+    }
+
+    /**
+     * @brief removeCircleEvent deletes the circle event of arc, if any, removing it from the queue
+     * @param arc
+     * @param pq
+     */
+    void removeCircleEvent(Leaf* arc, EventQueue& pq) {
+        if(arc->circleEvent) {
+            pq.remove(arc->circleEvent);
+            arc->circleEvent = nullptr;
         }
     }
 
-    void fortuneAlgorithm(const std::vector<cg3::Point2Dd>& points, DrawableVoronoiDiagram& dcel,
-                          const cg3::DrawableBoundingBox2D& boundingBox) {
-        double sweepline;
-        Beachline beachline(&sweepline);
-        std::priority_queue<Event*, std::vector<Event*>, EventComparator> pq;
+    /**
+     * @brief fortuneAlgorithm computes the Voronoi diagram of points with the Fortune's sweepline algorithm
+     * @param points: the sites of the diagram, a vector of points or a view of the coordinates of the caller
+     * @param dcel: the DCEL where the diagram is stored, it can be a plain DCEL or any class derived from it
+     * @param boundingBox: the box used to clip the diagram, the cells are closed by its boundary
+     * @param statistics: if not null, it is filled with the counters of the run
+     */
+    void fortuneAlgorithm(const SiteSpan& points, DCEL& dcel,
+                          const cg3::BoundingBox2D& boundingBox, SweepStatistics* statistics) {
+        SweepWorkspace workspace;
+        fortuneAlgorithm(points, dcel, boundingBox, workspace, statistics);
+    }
 
-        for(const cg3::Point2Dd& p : points) {
-            pq.push(static_cast<Event*>(new SiteEvent(p)));
+    /**
+     * @brief fortuneAlgorithm computes the Voronoi diagram of points with the Fortune's sweepline algorithm,
+     * using the beachline, the queue and the buffers of workspace instead of new ones
+     * @param points: the sites of the diagram, a site equal to another one gets a face without a cell, in the ring
+     * of coincident faces of the one with the cell
+     * @param dcel: the DCEL where the diagram is stored, it can be a plain DCEL or any class derived from it
+     * @param boundingBox: the box used to clip the diagram, the cells are closed by its boundary
+     * @param workspace: cleared and reused, its memory is kept for the next runs
+     * @param statistics: if not null, it is filled with the counters of the run
+     */
+    void fortuneAlgorithm(const SiteSpan& points, DCEL& dcel,
+                          const cg3::BoundingBox2D& boundingBox, SweepWorkspace& workspace, SweepStatistics* statistics) {
+        double& sweepline = workspace.sweepline;
+        Beachline& beachline = workspace.beachline;
+        EventQueue& pq = workspace.pq;
+        SweepStatistics sweepStatistics;
+        beachline.clear();
+        pq.clear();
+
+        //Site events are consumed in order from the sorted sequence of sites, the queue holds circle events only
+        std::vector<size_t>& siteOrder = workspace.siteOrder;
+        sortSitesByY(points, siteOrder, workspace.sortBuffers);
+        size_t nextSite = 0;
+
+        //A face for each site, in the same order of points
+        dcel.fitOrigin(boundingBox);
+        size_t firstFace = dcel.getFaces().size();
+        dcel.getFaces().reserve(firstFace + points.size());
+        for(size_t i = 0; i < points.size(); i++)
+            dcel.addFace(Face(points[i]));
+        beachline.setSites(points, firstFace);
+
+        //Equal sites are adjacent in the order: only the first one is swept, the others get a face without a cell
+        //linked to its face
+        size_t nUnique = 0;
+        for(size_t i = 0; i < siteOrder.size(); i++) {
+            if(nUnique > 0 && points.x(siteOrder[i]) == points.x(siteOrder[nUnique-1]) &&
+                    points.y(siteOrder[i]) == points.y(siteOrder[nUnique-1]))
+                dcel.linkCoincidentFaces(firstFace + siteOrder[nUnique-1], firstFace + siteOrder[i]);
+            else
+                siteOrder[nUnique++] = siteOrder[i];
+        }
+        siteOrder.resize(nUnique);
+
+        //The sites on the first sweepline are separated by vertical bisectors, their arcs are added all together
+        while(nextSite < siteOrder.size() && points.y(siteOrder[nextSite]) == points.y(siteOrder[0]))
+            nextSite++;
+        if(nextSite > 0) {
+            sweepline = points.y(siteOrder[0]);
+            beachline.addFirstRow(siteOrder.data(), nextSite, dcel);
         }
 
-        while(!pq.empty()) {
-            Event* e = pq.top();
-            pq.pop();
-            sweepline = e->getPoint().y();
+        while(nextSite < siteOrder.size() || !pq.empty()) {
+            //In case of ties circle events are handled before site events
+            if(nextSite < siteOrder.size() && (pq.empty() || points.y(siteOrder[nextSite]) > pq.top()->getY())) {
+                const size_t site = siteOrder[nextSite++];
+                sweepline = points.y(site);
 
-            if(e->getType() == Event::EventType::SITE) {
                 Leaf* newPoint = nullptr;
-                CircleEvent* oldPointEvent = beachline.addPoint(e->getPoint(), newPoint, dcel.getHalfEdges());
+                CircleEvent* oldPointEvent = beachline.addPoint(site, newPoint, dcel);
 
                 if(newPoint) {//if it is nullptr, the beachline was empty before the addPoint
                     if(oldPointEvent)
-                        oldPointEvent->setType(Event::EventType::FALSE);
+                        pq.remove(oldPointEvent);
 
-                    checkCircleEvent(newPoint, newPoint->next, newPoint->next->next, sweepline, pq);
-                    checkCircleEvent(newPoint, newPoint->prev, newPoint->prev->prev, sweepline, pq);
+                    checkCircleEvent(newPoint->next, points, sweepline, pq, sweepStatistics);
+                    checkCircleEvent(newPoint->prev, points, sweepline, pq, sweepStatistics);
                 }
-            } else if(e->getType() == Event::EventType::CIRCLE) {
-                CircleEvent* cE = static_cast<CircleEvent*>(e);
+            } else {
+                CircleEvent* cE = pq.pop();
+                sweepline = cE->getY();
                 Leaf* prev = beachline.removePoint(cE, dcel);
 
-                //If null it is a false alarm
-                if(!prev)
-                    continue;
-
                 //Saving prev and next pointers of the arc that is going to be removed
                 prev->next->next->prev = prev;
                 prev->next = prev->next->next;
 
                 //Delete circle events involving arc
-                if(prev->circleEvent) {
-                    prev->circleEvent->setType(Event::EventType::FALSE);
-                    prev->circleEvent = nullptr;
-                }
-                if(prev->next->circleEvent) {
-                    prev->next->circleEvent->setType(Event::EventType::FALSE);
-                    prev->next->circleEvent = nullptr;
-                }
+                removeCircleEvent(prev, pq);
+                removeCircleEvent(prev->next, pq);
+
+                checkCircleEvent(prev, points, sweepline, pq, sweepStatistics);
+                checkCircleEvent(prev->next, points, sweepline, pq, sweepStatistics);
 
-                checkCircleEvent(prev->next, prev, prev->prev, sweepline, pq);
-                checkCircleEvent(prev, prev->next, prev->next->next, sweepline, pq);
+                pq.release(cE);
             }
+        }
 
-            delete e;
+        if(statistics) {
+            *statistics = sweepStatistics;
+            statistics->eventQueue = pq.getStatistics();
         }
 
-        //Connect halfedges to the bounding box
-        std::vector<HalfEdge>& edges = dcel.getHalfEdges();
-        std::vector<Vertex>& vertexs = dcel.getVertexs();
-        for(size_t i=0; i < edges.size(); i++) {
-            if(edges[i].getOriginID() != std::numeric_limits<size_t>::max()) {
-                if(!boundingBox.isInside(dcel.getHEOrigin(i).getCoordinates())) {
-                    if(edges[edges[i].getTwinID()].getOriginID() != std::numeric_limits<size_t>::max()) {
-                        const cg3::Point2Dd& vIn = vertexs[edges[edges[i].getTwinID()].getOriginID()].getCoordinates();
-                        size_t index = edges[i].getOriginID();
-                        const cg3::Point2Dd& vOut = vertexs[index].getCoordinates();
-                        if(boundingBox.isInside(vIn)) {
-                            if(vOut.y()>0) {
-                                cg3::Segment2Dd topSide(cg3::Point2Dd(boundingBox.min().x(), boundingBox.max().y()),
-                                                        boundingBox.max());
-                                if (cg3::checkSegmentIntersection(cg3::Segment2Dd(vIn, vOut), topSide, true)) {
-                                    double yBB = topSide.getP1().y();
-                                    double xNew = vIn.x()+(yBB-vIn.y())*(vOut.x()-vIn.x())/(vOut.y()-vIn.y());
-                                    edges[i].setOrigin(dcel.addVertex(Vertex(cg3::Point2Dd(xNew, yBB),i)));
-                                    vertexs[index].setIncidEdge(std::numeric_limits<size_t>::max());
-                                } else if(vOut.x() > 0) {
-                                    cg3::Segment2Dd rightSide(cg3::Point2Dd(boundingBox.max().x(), boundingBox.min().y()),
-                                                              boundingBox.max());
-                                    if(cg3::checkSegmentIntersection(cg3::Segment2Dd(vIn, vOut), rightSide, true)) {
-                                        double xBB = rightSide.getP1().x();
-                                        double yNew = vIn.y()+(xBB-vIn.x())*(vOut.y()-vIn.y())/(vOut.x()-vIn.x());
-                                        edges[i].setOrigin(dcel.addVertex(Vertex(cg3::Point2Dd(xBB, yNew),i)));
-                                        vertexs[index].setIncidEdge(std::numeric_limits<size_t>::max());
-                                    }
-                                } else {
-                                    cg3::Segment2Dd leftSide(cg3::Point2Dd(boundingBox.min().x(), boundingBox.max().y()),
-                                                             boundingBox.min());
-                                    if(cg3::checkSegmentIntersection(cg3::Segment2Dd(vIn, vOut), leftSide, true)) {
-                                        double xBB = leftSide.getP1().x();
-                                        double yNew = vIn.y()+(xBB-vIn.x())*(vOut.y()-vIn.y())/(vOut.x()-vIn.x());
-                                        edges[i].setOrigin(dcel.addVertex(Vertex(cg3::Point2Dd(xBB, yNew),i)));
-                                        vertexs[index].setIncidEdge(std::numeric_limits<size_t>::max());
-                                    }
-                                }
-                            } else {
-                                cg3::Segment2Dd bottomSide(cg3::Point2Dd(boundingBox.max().x(), boundingBox.min().y()),
-                                                           boundingBox.min());
-                                if(cg3::checkSegmentIntersection(cg3::Segment2Dd(vIn, vOut), bottomSide, true)) {
-                                    double yBB = bottomSide.getP1().y();
-                                    double xNew = vIn.x()+(yBB-vIn.y())*(vOut.x()-vIn.x())/(vOut.y()-vIn.y());
-                                    edges[i].setOrigin(dcel.addVertex(Vertex(cg3::Point2Dd(xNew, yBB),i)));
-                                    vertexs[index].setIncidEdge(std::numeric_limits<size_t>::max());
-                                } else if(vOut.x() > 0) {
-                                    cg3::Segment2Dd rightSide(cg3::Point2Dd(boundingBox.max().x(), boundingBox.min().y()),
-                                                              boundingBox.max());
-                                    if(cg3::checkSegmentIntersection(cg3::Segment2Dd(vIn, vOut), rightSide, true)) {
-                                        double xBB = rightSide.getP1().x();
-                                        double yNew = vIn.y()+(xBB-vIn.x())*(vOut.y()-vIn.y())/(vOut.x()-vIn.x());
-                                        edges[i].setOrigin(dcel.addVertex(Vertex(cg3::Point2Dd(xBB, yNew),i)));
-                                        vertexs[index].setIncidEdge(std::numeric_limits<size_t>::max());
-                                    }
-                                } else {
-                                    cg3::Segment2Dd leftSide(cg3::Point2Dd(boundingBox.min().x(), boundingBox.max().y()),
-                                                             boundingBox.min());
-                                    if(cg3::checkSegmentIntersection(cg3::Segment2Dd(vIn, vOut), leftSide, true)) {
-                                        double xBB = leftSide.getP1().x();
-                                        double yNew = vIn.y()+(xBB-vIn.x())*(vOut.y()-vIn.y())/(vOut.x()-vIn.x());
-                                        edges[i].setOrigin(dcel.addVertex(Vertex(cg3::Point2Dd(xBB, yNew),i)));
-                                        vertexs[index].setIncidEdge(std::numeric_limits<size_t>::max());
-                                    }
-                                }
-                            }
-                        } else {
-                            vertexs[edges[i].getOriginID()].setIncidEdge(std::numeric_limits<size_t>::max());
-                            edges[i].setOrigin(std::numeric_limits<size_t>::max());
-                        }
-                    } else {
-                        vertexs[edges[i].getOriginID()].setIncidEdge(std::numeric_limits<size_t>::max());
-                        edges[i].setOrigin(std::numeric_limits<size_t>::max());
-                    }
-                }
+        clipDiagram(dcel, boundingBox, workspace.clippingBuffers);
+    }
 
-            }
+    /**
+     * @brief computeVoronoiDiagram computes the Voronoi diagram of points with the chosen engine
+     * @param points: the sites of the diagram
+     * @param dcel: the DCEL where the diagram is stored
+     * @param boundingBox: the box used to clip the diagram, the cells are closed by its boundary
+     * @param engine: fortuneAlgorithm, delaunayAlgorithm, exactDelaunayAlgorithm or halfPlaneAlgorithm.
+     * The Fortune's engine computes the diagrams of up to 12 sites with halfPlaneAlgorithm, which has no setup cost
+     */
+    void computeVoronoiDiagram(const std::vector<cg3::Point2Dd>& points, DCEL& dcel,
+                               const cg3::BoundingBox2D& boundingBox, VoronoiEngine engine) {
+        switch(engine) {
+            case VoronoiEngine::DELAUNAY:
+                delaunayAlgorithm(points, dcel, boundingBox);
+                break;
+            case VoronoiEngine::EXACT:
+                exactDelaunayAlgorithm(points, dcel, boundingBox);
+                break;
+            case VoronoiEngine::HALF_PLANE:
+                halfPlaneAlgorithm(points, dcel, boundingBox);
+                break;
+            default:
+                if(points.size() <= HALF_PLANE_MAX_SIZE)
+                    halfPlaneAlgorithm(points, dcel, boundingBox);
+                else
+                    fortuneAlgorithm(points, dcel, boundingBox);
         }
     }
 
+    /**
+     * @brief computeVoronoiDiagram computes the Voronoi diagram of points with the Fortune's engine of computeVoronoiDiagram,
+     * sweeping with the beachline and the queue of workspace
+     * @param points: the sites of the diagram
+     * @param dcel: the DCEL where the diagram is stored
+     * @param boundingBox: the box used to clip the diagram, the cells are closed by its boundary
+     * @param workspace: reused by fortuneAlgorithm, it is not used by the diagrams of up to 12 sites
+     */
+    void computeVoronoiDiagram(const SiteSpan& points, DCEL& dcel,
+                               const cg3::BoundingBox2D& boundingBox, SweepWorkspace& workspace) {
+        if(points.size() <= HALF_PLANE_MAX_SIZE)
+            halfPlaneAlgorithm(points, dcel, boundingBox);
+        else
+            fortuneAlgorithm(points, dcel, boundingBox, workspace);
+    }
+
 }
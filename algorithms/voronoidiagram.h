@@ -1,20 +1,72 @@
 #ifndef VORONOIDIAGRAM_H
 #define VORONOIDIAGRAM_H
 
-#include <../data_structures/dcel.h>
-#include <../data_structures/beachline.h>
-#include <../mathVoronoi/circle.h>
-#include <../data_structures/event.h>
-#include <../viewer/drawablevoronoidiagram.h>
-#include <cg3/viewer/drawable_objects/2d/drawable_bounding_box2d.h>
-#include <cg3/geometry/2d/intersections2d.h>
-#include <queue>
+#include "../data_structures/dcel.h"
+#include "../data_structures/beachline.h"
+#include "../mathVoronoi/circle.h"
+#include "../data_structures/event.h"
+#include "../data_structures/eventqueue.h"
+#include "radixsort.h"
+#include "clipping.h"
+#include <cg3/geometry/2d/bounding_box2d.h>
 
 namespace Voronoi {
-    void fortuneAlgorithm(const std::vector<cg3::Point2Dd>& points, DrawableVoronoiDiagram& dcel,
-                          const cg3::DrawableBoundingBox2D& boundingBox);
-    void checkCircleEvent(const Leaf* l1, Leaf* middleArc, const Leaf* l3, const double& sweepline,
-                          std::priority_queue<Event*, std::vector<Event*>, EventComparator>& pq);
+    /**
+     * @brief The SweepStatistics struct, counters of the work done by a run of fortuneAlgorithm.
+     * rejectedCircleEvents counts the candidate circle events discarded because the breakpoints diverge
+     */
+    struct SweepStatistics {
+        EventQueueStatistics eventQueue;
+        size_t rejectedCircleEvents;
+
+        SweepStatistics() : rejectedCircleEvents(0) {}
+    };
+
+    /**
+     * @brief The SweepWorkspace struct, the beachline, the queue of circle events, the order of the sites
+     * and the buffers of the sort and of the clipping of a sweep.
+     * fortuneAlgorithm clears them at the start of the run and keeps their memory, so a workspace reused
+     * for many diagrams allocates only when a diagram is larger than the previous ones.
+     * The beachline refers to the sweepline of the workspace, so a workspace can't be copied
+     */
+    struct SweepWorkspace {
+        double sweepline;
+        Beachline beachline;
+        EventQueue pq;
+        std::vector<size_t> siteOrder;
+        RadixSortBuffers sortBuffers;
+        ClippingBuffers clippingBuffers;
+
+        SweepWorkspace() : sweepline(0), beachline(&sweepline) {}
+        SweepWorkspace(const SweepWorkspace&) = delete;
+        SweepWorkspace& operator=(const SweepWorkspace&) = delete;
+
+        void reserve(size_t nSites);
+    };
+
+    /**
+     * @brief The VoronoiEngine enum, the algorithms computeVoronoiDiagram can use: the Fortune's sweep,
+     * or the dual of the Delaunay triangulation built incrementally. Both produce the same DCEL.
+     * EXACT is the Delaunay engine with the sites snapped to an integer grid and exact predicates,
+     * HALF_PLANE clips the cells with the bisectors, the FORTUNE engine uses it for a few sites
+     */
+    enum class VoronoiEngine {
+        FORTUNE,
+        DELAUNAY,
+        EXACT,
+        HALF_PLANE
+    };
+
+    void computeVoronoiDiagram(const std::vector<cg3::Point2Dd>& points, DCEL& dcel,
+                               const cg3::BoundingBox2D& boundingBox, VoronoiEngine engine = VoronoiEngine::FORTUNE);
+    void computeVoronoiDiagram(const SiteSpan& points, DCEL& dcel,
+                               const cg3::BoundingBox2D& boundingBox, SweepWorkspace& workspace);
+    void fortuneAlgorithm(const SiteSpan& points, DCEL& dcel,
+                          const cg3::BoundingBox2D& boundingBox, SweepStatistics* statistics = nullptr);
+    void fortuneAlgorithm(const SiteSpan& points, DCEL& dcel,
+                          const cg3::BoundingBox2D& boundingBox, SweepWorkspace& workspace, SweepStatistics* statistics = nullptr);
+    void checkCircleEvent(Leaf* middleArc, const SiteSpan& sites, const double& sweepline, EventQueue& pq, SweepStatistics& statistics);
+    void removeCircleEvent(Leaf* arc, EventQueue& pq);
 }
 
 #endif // VORONOIDIAGRAM_H
@@ -0,0 +1,35 @@
+# Time per evaluation of a breakpoint of the beachline, with BreakpointFunction and with the intersections of the parabolas
+# of findIntersectionPoint used before it, built without Qt like VoronoiEngine.pro.
+# Usage: breakpoint_benchmark [number of breakpoints] [repetitions]
+
+TEMPLATE = app
+TARGET = breakpoint_benchmark
+
+CONFIG -= qt
+CONFIG += c++11 console
+
+CONFIG(release, debug|release){
+    unix:!macx{
+        QMAKE_CXXFLAGS_RELEASE -= -g -O2
+        QMAKE_CXXFLAGS += -O3 -DNDEBUG
+    }
+}
+
+win32 {
+    DEFINES += _USE_MATH_DEFINES
+}
+
+unix:!macx{
+    QMAKE_CXXFLAGS += -fopenmp
+    QMAKE_LFLAGS += -fopenmp
+}
+
+INCLUDEPATH += $$PWD/.. $$PWD/../cg3lib/cg3/core/
+
+include (../voronoi_engine.pri)
+
+SOURCES += \
+    $$PWD/breakpoint_benchmark.cpp
+
+HEADERS += \
+    $$PWD/benchmark.h
@@ -0,0 +1,35 @@
+# Throughput of the Fortune and the Delaunay engines on several distributions of sites, built without Qt like VoronoiEngine.pro,
+# and time per diagram of the sweep and of the half-plane solver on tiles of a few sites (the crossover of computeVoronoiDiagram).
+# Usage: engine_benchmark [number of sites] [repetitions]
+
+TEMPLATE = app
+TARGET = engine_benchmark
+
+CONFIG -= qt
+CONFIG += c++11 console
+
+CONFIG(release, debug|release){
+    unix:!macx{
+        QMAKE_CXXFLAGS_RELEASE -= -g -O2
+        QMAKE_CXXFLAGS += -O3 -DNDEBUG
+    }
+}
+
+win32 {
+    DEFINES += _USE_MATH_DEFINES
+}
+
+unix:!macx{
+    QMAKE_CXXFLAGS += -fopenmp
+    QMAKE_LFLAGS += -fopenmp
+}
+
+INCLUDEPATH += $$PWD/.. $$PWD/../cg3lib/cg3/core/
+
+include (../voronoi_engine.pri)
+
+SOURCES += \
+    $$PWD/engine_benchmark.cpp
+
+HEADERS += \
+    $$PWD/benchmark.h
@@ -0,0 +1,34 @@
+# Speedup of fortuneAlgorithmParallel by number of threads, built without Qt like VoronoiEngine.pro.
+# Usage: parallelfortune_benchmark [number of sites] [max threads] [repetitions]
+
+TEMPLATE = app
+TARGET = parallelfortune_benchmark
+
+CONFIG -= qt
+CONFIG += c++11 console
+
+CONFIG(release, debug|release){
+    unix:!macx{
+        QMAKE_CXXFLAGS_RELEASE -= -g -O2
+        QMAKE_CXXFLAGS += -O3 -DNDEBUG
+    }
+}
+
+win32 {
+    DEFINES += _USE_MATH_DEFINES
+}
+
+unix:!macx{
+    QMAKE_CXXFLAGS += -fopenmp
+    QMAKE_LFLAGS += -fopenmp
+}
+
+INCLUDEPATH += $$PWD/.. $$PWD/../cg3lib/cg3/core/
+
+include (../voronoi_engine.pri)
+
+SOURCES += \
+    $$PWD/parallelfortune_benchmark.cpp
+
+HEADERS += \
+    $$PWD/benchmark.h
@@ -0,0 +1,48 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <data_structures/dcel.h>
+
+#include <chrono>
+
+/**
+ * @brief milliseconds the best time of repetitions runs of f
+ */
+template<class F>
+inline double milliseconds(F f, int repetitions) {
+    double best = 0;
+    for(int r = 0; r < repetitions; r++) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        f();
+        double time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if(r == 0 || time < best)
+            best = time;
+    }
+    return best;
+}
+
+/**
+ * @brief sameCells true if the two diagrams have cells with the same number of vertexs for each face
+ */
+inline bool sameCells(const Voronoi::DCEL& a, const Voronoi::DCEL& b) {
+    if(a.getFaces().size() != b.getFaces().size())
+        return false;
+    for(size_t f = 0; f < a.getFaces().size(); f++) {
+        size_t sizes[2] = {0, 0};
+        const Voronoi::DCEL* diagrams[2] = {&a, &b};
+        for(int d = 0; d < 2; d++) {
+            size_t start = diagrams[d]->getFaces()[f].getIncidEdgeID(), e = start;
+            if(start == std::numeric_limits<size_t>::max())
+                continue;
+            do {
+                sizes[d]++;
+                e = diagrams[d]->getHalfEdges()[e].getNextID();
+            } while(e != start);
+        }
+        if(sizes[0] != sizes[1])
+            return false;
+    }
+    return true;
+}
+
+#endif // BENCHMARK_H
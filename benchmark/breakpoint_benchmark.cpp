@@ -0,0 +1,90 @@
+#include <mathVoronoi/parabola.h>
+#include "benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+/**
+ * @brief intersectionX the x-coordinate of the breakpoint as the beachline computed it before BreakpointFunction:
+ * the intersections of the two parabolas from findIntersectionPoint, the right one if the left focus is the lower one
+ */
+double intersectionX(const cg3::Point2Dd& left, const cg3::Point2Dd& right, double sweepline) {
+    std::vector<cg3::Point2Dd> points = Voronoi::findIntersectionPoint(left, right, sweepline);
+    if(points.size() == 2)
+        return left.y() < right.y() ? points[1].x() : points[0].x();
+    return points[0].x();
+}
+
+/**
+ * @brief referenceX the x-coordinate of the breakpoint computed in long double from the quadratic of BreakpointFunction,
+ * with the same choice of the intersection
+ */
+long double referenceX(const cg3::Point2Dd& left, const cg3::Point2Dd& right, double sweepline) {
+    long double hl = left.y() - static_cast<long double>(sweepline), hr = right.y() - static_cast<long double>(sweepline);
+    long double u = right.x() - static_cast<long double>(left.x()), a = right.y() - static_cast<long double>(left.y());
+    if(a == 0)
+        return left.x() + u/2;
+    long double root = std::sqrt(hl*hr*(u*u + a*a));
+    long double x1 = (-hl*u + root)/a, x2 = (-hl*u - root)/a;
+    return left.x() + (left.y() < right.y() ? std::max(x1, x2) : std::min(x1, x2));
+}
+
+int main(int argc, char* argv[]) {
+    size_t nPairs = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    int repetitions = argc > 2 ? std::atoi(argv[2]) : 5;
+    const size_t nSweeplines = 16;
+
+    //Pairs of foci in the unit square, evaluated on sweeplines below both of them: each evaluation has a new sweepline,
+    //so the memoized value of BreakpointFunction is never used
+    std::mt19937_64 generator(0);
+    std::uniform_real_distribution<double> coordinate(0, 1);
+    std::vector<cg3::Point2Dd> lefts(nPairs), rights(nPairs);
+    std::vector<Voronoi::BreakpointFunction> functions;
+    functions.reserve(nPairs);
+    for(size_t i = 0; i < nPairs; i++) {
+        lefts[i] = cg3::Point2Dd(coordinate(generator), coordinate(generator));
+        rights[i] = cg3::Point2Dd(coordinate(generator), coordinate(generator));
+        functions.push_back(Voronoi::BreakpointFunction(lefts[i].x(), lefts[i].y(), rights[i].x(), rights[i].y()));
+    }
+    std::vector<double> sweeplines(nSweeplines);
+    for(size_t s = 0; s < nSweeplines; s++)
+        sweeplines[s] = -0.01 - s*0.05;
+
+    double oldSum = 0, newSum = 0;
+    double oldTime = milliseconds([&]() {
+        for(size_t s = 0; s < nSweeplines; s++) {
+            for(size_t i = 0; i < nPairs; i++)
+                oldSum += intersectionX(lefts[i], rights[i], sweeplines[s]);
+        }
+    }, repetitions);
+    double newTime = milliseconds([&]() {
+        for(size_t s = 0; s < nSweeplines; s++) {
+            for(size_t i = 0; i < nPairs; i++)
+                newSum += functions[i].x(sweeplines[s]);
+        }
+    }, repetitions);
+
+    //Largest error of the two against the long double evaluation, relative to the distance of the breakpoint from the left focus
+    //(findIntersectionPoint takes the foci with y closer than POINT_EPSILON as a single intersection at the middle)
+    double oldError = 0, newError = 0;
+    for(size_t s = 0; s < nSweeplines; s++) {
+        for(size_t i = 0; i < nPairs; i++) {
+            long double expected = referenceX(lefts[i], rights[i], sweeplines[s]);
+            double scale = std::max(static_cast<double>(std::fabs(expected - lefts[i].x())), lefts[i].dist(rights[i]));
+            oldError = std::max(oldError, static_cast<double>(std::fabs(intersectionX(lefts[i], rights[i], sweeplines[s]) - expected))/scale);
+            newError = std::max(newError, static_cast<double>(std::fabs(functions[i].x(sweeplines[s]) - expected))/scale);
+        }
+    }
+
+    const double nEvaluations = static_cast<double>(nPairs*nSweeplines);
+    std::printf("%zu breakpoints, %zu sweeplines\n", nPairs, nSweeplines);
+    std::printf("\t\t\ttime (ns)\tlargest relative error\n");
+    std::printf("findIntersectionPoint\t%.1f\t\t%.1e\n", oldTime*1e6/nEvaluations, oldError);
+    std::printf("BreakpointFunction\t%.1f\t\t%.1e\n", newTime*1e6/nEvaluations, newError);
+    std::printf("speedup %.1f\n", oldTime/newTime);
+    //The sums keep the evaluations from being optimized away
+    return oldSum == newSum + 1 ? 1 : 0;
+}
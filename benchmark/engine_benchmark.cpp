@@ -0,0 +1,116 @@
+#include <algorithms/voronoidiagram.h>
+#include <algorithms/halfplane.h>
+#include "benchmark.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+/**
+ * @brief sites n sites of the distribution in the square [-size, size]^2:
+ * 0 uniform, 1 gaussian, 2 clustered around 32 centers, 3 near a circle
+ */
+std::vector<cg3::Point2Dd> sites(size_t n, int distribution, double size) {
+    std::mt19937_64 generator(distribution);
+    std::uniform_real_distribution<double> uniform(-size, size);
+    std::normal_distribution<double> normal(0, size/4);
+    std::vector<cg3::Point2Dd> centers(32);
+    for(cg3::Point2Dd& c : centers)
+        c = cg3::Point2Dd(uniform(generator)*0.8, uniform(generator)*0.8);
+
+    std::vector<cg3::Point2Dd> points;
+    points.reserve(n);
+    while(points.size() < n) {
+        cg3::Point2Dd p;
+        switch(distribution) {
+            case 0:
+                p = cg3::Point2Dd(uniform(generator), uniform(generator));
+                break;
+            case 1:
+                p = cg3::Point2Dd(normal(generator), normal(generator));
+                break;
+            case 2: {
+                const cg3::Point2Dd& c = centers[generator() % centers.size()];
+                p = cg3::Point2Dd(c.x() + normal(generator)/16, c.y() + normal(generator)/16);
+                break;
+            }
+            default: {
+                double angle = uniform(generator)*M_PI/size, radius = size*0.9 + normal(generator)/64;
+                p = cg3::Point2Dd(radius*std::cos(angle), radius*std::sin(angle));
+            }
+        }
+        if(std::abs(p.x()) < size && std::abs(p.y()) < size)
+            points.push_back(p);
+    }
+    return points;
+}
+
+int main(int argc, char* argv[]) {
+    size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+    int repetitions = argc > 2 ? std::atoi(argv[2]) : 3;
+
+    const double size = 1e6;
+    cg3::BoundingBox2D boundingBox(cg3::Point2Dd(-size, -size), cg3::Point2Dd(size, size));
+    const char* names[4] = {"uniform", "gaussian", "clustered", "circle"};
+
+    std::printf("%zu sites\n", n);
+    std::printf("distribution\tfortune (ms)\tdelaunay (ms)\texact (ms)\tratio\tsame cells\n");
+    for(int distribution = 0; distribution < 4; distribution++) {
+        std::vector<cg3::Point2Dd> points = sites(n, distribution, size);
+        Voronoi::DCEL fortune, delaunay, exact;
+        double fortuneTime = milliseconds([&]() {
+            fortune.clear();
+            Voronoi::computeVoronoiDiagram(points, fortune, boundingBox, Voronoi::VoronoiEngine::FORTUNE);
+        }, repetitions);
+        double delaunayTime = milliseconds([&]() {
+            delaunay.clear();
+            Voronoi::computeVoronoiDiagram(points, delaunay, boundingBox, Voronoi::VoronoiEngine::DELAUNAY);
+        }, repetitions);
+        double exactTime = milliseconds([&]() {
+            exact.clear();
+            Voronoi::computeVoronoiDiagram(points, exact, boundingBox, Voronoi::VoronoiEngine::EXACT);
+        }, repetitions);
+        std::printf("%s\t%s%.1f\t\t%.1f\t\t%.1f\t\t%.2f\t%s\n", names[distribution], distribution == 0 || distribution == 3 ? "\t" : "",
+                    fortuneTime, delaunayTime, exactTime, fortuneTime/delaunayTime, sameCells(fortune, delaunay) ? "yes" : "no");
+    }
+
+    //Crossover of the small diagrams: many tiles of a few uniform sites, the time is per diagram
+    std::printf("\nsites per diagram\tfortune (us)\thalf-plane (us)\tratio\tsame cells\n");
+    const size_t tileSizes[] = {3, 4, 6, 8, 10, 12, 14, 16, 24, 32, 48, 64};
+    for(size_t tileSize : tileSizes) {
+        const size_t nTiles = std::max<size_t>(n/tileSize, 1);
+        std::vector<std::vector<cg3::Point2Dd>> tiles(nTiles);
+        std::mt19937_64 generator(tileSize);
+        std::uniform_real_distribution<double> uniform(-size, size);
+        for(std::vector<cg3::Point2Dd>& tile : tiles) {
+            for(size_t i = 0; i < tileSize; i++)
+                tile.push_back(cg3::Point2Dd(uniform(generator), uniform(generator)));
+        }
+        Voronoi::DCEL fortune, halfPlane;
+        bool same = true;
+        double fortuneTime = milliseconds([&]() {
+            for(const std::vector<cg3::Point2Dd>& tile : tiles) {
+                fortune.clear();
+                Voronoi::fortuneAlgorithm(tile, fortune, boundingBox);
+            }
+        }, repetitions);
+        double halfPlaneTime = milliseconds([&]() {
+            for(const std::vector<cg3::Point2Dd>& tile : tiles) {
+                halfPlane.clear();
+                Voronoi::halfPlaneAlgorithm(tile, halfPlane, boundingBox);
+            }
+        }, repetitions);
+        for(size_t t = 0; t < nTiles && t < 100; t++) {
+            fortune.clear();
+            halfPlane.clear();
+            Voronoi::fortuneAlgorithm(tiles[t], fortune, boundingBox);
+            Voronoi::halfPlaneAlgorithm(tiles[t], halfPlane, boundingBox);
+            same = same && sameCells(fortune, halfPlane);
+        }
+        std::printf("%zu\t\t\t%.2f\t\t%.2f\t\t%.2f\t%s\n", tileSize, fortuneTime*1000/nTiles, halfPlaneTime*1000/nTiles,
+                    fortuneTime/halfPlaneTime, same ? "yes" : "no");
+    }
+
+    return 0;
+}
@@ -0,0 +1,52 @@
+#include <algorithms/voronoidiagram.h>
+#include <algorithms/parallelfortune.h>
+#include "benchmark.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+int main(int argc, char* argv[]) {
+    size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+    int maxThreads = 1;
+    #ifdef _OPENMP
+    maxThreads = omp_get_max_threads();
+    #endif
+    if(argc > 2)
+        maxThreads = std::atoi(argv[2]);
+    int repetitions = argc > 3 ? std::atoi(argv[3]) : 3;
+
+    const double size = 1e6;
+    cg3::BoundingBox2D boundingBox(cg3::Point2Dd(-size, -size), cg3::Point2Dd(size, size));
+    std::mt19937_64 generator(0);
+    std::uniform_real_distribution<double> coordinate(-size, size);
+    std::vector<cg3::Point2Dd> points(n);
+    for(cg3::Point2Dd& p : points)
+        p = cg3::Point2Dd(coordinate(generator), coordinate(generator));
+
+    Voronoi::DCEL sequential;
+    double sequentialTime = milliseconds([&]() {
+        sequential.clear();
+        Voronoi::fortuneAlgorithm(points, sequential, boundingBox);
+    }, repetitions);
+    std::printf("%zu sites, sequential sweep: %.1f ms\n", n, sequentialTime);
+    std::printf("threads\ttime (ms)\tspeedup\tefficiency\tsame cells\n");
+
+    for(int threads = 1; threads <= maxThreads; threads *= 2) {
+        Voronoi::DCEL parallel;
+        double time = milliseconds([&]() {
+            parallel.clear();
+            Voronoi::fortuneAlgorithmParallel(points, parallel, boundingBox, threads);
+        }, repetitions);
+        std::printf("%d\t%.1f\t\t%.2f\t%.2f\t\t%s\n", threads, time, sequentialTime/time, sequentialTime/time/threads,
+                    sameCells(sequential, parallel) ? "yes" : "no");
+        if(threads < maxThreads && 2*threads > maxThreads)
+            threads = maxThreads/2;
+    }
+
+    return 0;
+}
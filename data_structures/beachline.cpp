@@ -3,23 +3,24 @@
 
 namespace Voronoi {
 
-    Beachline::Beachline(const Beachline& bl) {
+    Beachline::Beachline(const Beachline& bl) : root(nullptr), sweepline(bl.sweepline), sites(bl.sites), firstFace(bl.firstFace) {
         this->root = copyBeachline(bl.root);
-        updateAttributes(this->root);
     }
 
-    Beachline::Beachline(Beachline&& bl) {
-        this->root = bl.root;
-        this->sweepline = bl.sweepline;
-
-        bl.root = nullptr;
-        bl.sweepline = nullptr;
+    Beachline::Beachline(Beachline&& bl) : root(nullptr), sweepline(nullptr), firstFace(0) {
+        swap(bl);
     }
 
     void Beachline::swap(Beachline& bl) {
         using std::swap;
         swap(this->root, bl.root);
         swap(this->sweepline, bl.sweepline);
+        swap(this->sites, bl.sites);
+        swap(this->firstFace, bl.firstFace);
+        this->leafPool.swap(bl.leafPool);
+        this->internalNodePool.swap(bl.internalNodePool);
+        this->balanceBuffer.swap(bl.balanceBuffer);
+        this->pathBuffer.swap(bl.pathBuffer);
     }
 
     Beachline& Beachline::operator=(Beachline bl) {
@@ -28,19 +29,16 @@ namespace Voronoi {
     }
 
     Beachline& Beachline::operator=(Beachline&& bl) {
-        deleteNode(this->root);
-
-        std::swap(this->root, bl.root);
-        std::swap(this->sweepline, bl.sweepline);
+        clear();
+        swap(bl);
 
         return *this;
     }
 
     /**
-     * @brief Beachline::~Beachline
+     * @brief Beachline::~Beachline the nodes are released all together with the memory of the pools
      */
     Beachline::~Beachline() {
-        deleteNode(root);
     }
 
     /**
@@ -105,44 +103,32 @@ namespace Voronoi {
      * @param _node which value is returned
      * @return value of the node:
      *  - if Leaf returns site.x
-     *  - if InternalNode returns intersections of parabolas
+     *  - if InternalNode returns the x-coordinate of the breakpoint, the intersection of the parabolas
      */
     double Beachline::getValue(Node* _node) const {
-        if(isLeaf(_node)) {
-            return static_cast<Leaf*>(_node)->site->x();
-        } else {
-            InternalNode* node = static_cast<InternalNode*>(_node);
-
-            std::vector<cg3::Point2Dd> intPoints = Voronoi::findIntersectionPoint(*node->breakpoint.first, *node->breakpoint.second, *sweepline);
-
-            if(intPoints.size() == 2) {
-                if (node->breakpoint.first->y() < node->breakpoint.second->y())
-                    return intPoints[1].x();
-                else
-                    return intPoints[0].x();
-            } else {
-                return intPoints[0].x();
-            }
-        }
+        if(isLeaf(_node))
+            return sites.x(static_cast<Leaf*>(_node)->site);
+        else
+            return static_cast<InternalNode*>(_node)->breakpointFunction.x(*sweepline);
     }
 
     /**
      * @brief Beachline::makeSubtree creates a subtree for a new siteEvent
      * @param node
-     * @param p: the new site to be added to the Beachline
+     * @param site: the index of the new site to be added to the Beachline
      * @return the pointer to the circleEvent to check if it is a false alarm
      */
-    CircleEvent* Beachline::makeSubtree(Node*& node, const cg3::Point2Dd& p, std::vector<Voronoi::HalfEdge>& edges) {
+    CircleEvent* Beachline::makeSubtree(Node*& node, size_t site, DCEL& dcel) {
         Leaf* leaf = static_cast<Leaf*>(node);
-        InternalNode* newNode = new InternalNode(node->parent,
-                                                 new Leaf(nullptr, leaf->prev, nullptr, leaf->site),
-                                                 new InternalNode(nullptr,
-                                                                  new Leaf(nullptr, nullptr, nullptr, &p),
-                                                                  new Leaf(nullptr, nullptr, leaf->next, leaf->site),
+        InternalNode* newNode = internalNodePool.create(node->parent,
+                                                 leafPool.create(nullptr, leaf->prev, nullptr, leaf->site),
+                                                 internalNodePool.create(nullptr,
+                                                                  leafPool.create(nullptr, nullptr, nullptr, site),
+                                                                  leafPool.create(nullptr, nullptr, leaf->next, leaf->site),
                                                                   1,
-                                                                  std::pair<const cg3::Point2Dd*, const cg3::Point2Dd*>(&p, leaf->site)),
+                                                                  std::pair<size_t, size_t>(site, leaf->site), sites),
                                                  2,
-                                                 std::pair<const cg3::Point2Dd*, const cg3::Point2Dd*>(leaf->site, &p));
+                                                 std::pair<size_t, size_t>(leaf->site, site), sites);
         //Connecting the parent for each new Node
         newNode->left->parent = newNode;
         newNode->right->parent = newNode;
@@ -160,12 +146,17 @@ namespace Voronoi {
         if(leaf->next)
             leaf->next->prev = static_cast<Leaf*>(newNode->right->right);
 
-        //HalfEdges creation and pointers added to each breakpoint in Beachline
-        size_t lastIndex = edges.size();
-        edges.push_back(Voronoi::HalfEdge());
-        edges.back().setTwin(lastIndex+1);
-        edges.push_back(Voronoi::HalfEdge());
-        edges.back().setTwin(lastIndex);
+        //Connecting the leaves to their breakpoints, the ones of the split leaf are kept by the external leaves
+        static_cast<Leaf*>(newNode->left)->leftBreakpoint = leaf->leftBreakpoint;
+        static_cast<Leaf*>(newNode->left)->rightBreakpoint = newNode;
+        static_cast<Leaf*>(newNode->right->left)->leftBreakpoint = newNode;
+        static_cast<Leaf*>(newNode->right->left)->rightBreakpoint = static_cast<InternalNode*>(newNode->right);
+        static_cast<Leaf*>(newNode->right->right)->leftBreakpoint = static_cast<InternalNode*>(newNode->right);
+        static_cast<Leaf*>(newNode->right->right)->rightBreakpoint = leaf->rightBreakpoint;
+
+        //HalfEdges creation and pointers added to each breakpoint in Beachline,
+        //the halfEdge of the breakpoint (a, b) is on the face of a, its twin on the face of b
+        size_t lastIndex = dcel.addHalfEdgePair(getFace(leaf->site), getFace(site));
 
         newNode->edge = lastIndex;
         static_cast<InternalNode*>(newNode->right)->edge = lastIndex+1;
@@ -180,7 +171,7 @@ namespace Voronoi {
 
         CircleEvent* cEvent = leaf->circleEvent;
 
-        delete node;
+        leafPool.destroy(leaf);
         node = newNode;
 
         return cEvent;
@@ -188,24 +179,26 @@ namespace Voronoi {
 
     /**
      * @brief Beachline::addPoint add a point to the Beachline, creating a subtree and rebalancing the Beachline
-     * @param p: the point to be added
+     * @param site: the index of the site to be added
      * @param newPoint: the reference to the leaf representing the new point, it will be used to check circle events
-     * @param edges: the vector containing the edges of the Voronoi diagram
+     * @param dcel: the DCEL of the Voronoi diagram
      * @return the Event linked to the substitued leaf to check for false alarm
      */
-    CircleEvent* Beachline::addPoint(const cg3::Point2Dd& p, Leaf*& newPoint, std::vector<Voronoi::HalfEdge>& edges) {
+    CircleEvent* Beachline::addPoint(size_t site, Leaf*& newPoint, DCEL& dcel) {
         if(!root) {
-            root = new Leaf(&p);
+            root = leafPool.create(site);
             return nullptr;
         } else {
             //stores the balance of the children for each node visited to find the arc (pair.first takes the
-            std::vector<std::pair<int,int>> _balance;
+            std::vector<std::pair<int,int>>& _balance = balanceBuffer;
             //stores the path to the arc (-1 for left child, 1 for right child)
-            std::vector<int> path;
+            std::vector<int>& path = pathBuffer;
+            _balance.clear();
+            path.clear();
             //store the differences of balance, diff += (pair.first - pair.second), for each pair
             int last = 0, diff = 0;
-            Node* arc = findArc(p.x(), _balance, path, diff, last);
-            CircleEvent* cEvent = makeSubtree(arc, p, edges);
+            Node* arc = findArc(sites.x(site), _balance, path, diff, last);
+            CircleEvent* cEvent = makeSubtree(arc, site, dcel);
             newPoint = static_cast<Leaf*>(arc->right->left);
             //Here (in this line of code) heights of the tree have not been updated yet
             if(arc != root) {
@@ -216,84 +209,96 @@ namespace Voronoi {
         }
     }
 
+    /**
+     * @brief Beachline::addFirstRow adds to an empty Beachline the arcs of the sites met by the first sweepline.
+     * The sites have the same y-coordinate, so each arc is a vertical ray and the bisector of two consecutive sites
+     * is a vertical line: the arcs are added side by side in x order, in a balanced subtree, instead of splitting
+     * each other as addPoint would do
+     * @param row: the indices of the sites, with increasing x-coordinate and without duplicates
+     * @param size: the number of sites, at least 1
+     * @param dcel: the DCEL of the Voronoi diagram, it gets a pair of halfEdges for each bisector
+     */
+    void Beachline::addFirstRow(const size_t* row, size_t size, DCEL& dcel) {
+        Leaf* last = nullptr;
+        root = makeRow(row, size, nullptr, last, dcel);
+    }
+
+    /**
+     * @brief Beachline::makeRow builds the balanced subtree of the arcs of row for addFirstRow
+     * @param parent: the parent of the subtree
+     * @param last: the last leaf created before the subtree, it is updated with the last leaf of the subtree
+     * @return the root of the subtree
+     */
+    Node* Beachline::makeRow(const size_t* row, size_t size, Node* parent, Leaf*& last, DCEL& dcel) {
+        if(size == 1) {
+            Leaf* leaf = leafPool.create(parent, last, nullptr, row[0]);
+            if(last) {
+                last->next = leaf;
+                leaf->leftBreakpoint = last->rightBreakpoint;
+            }
+            last = leaf;
+            return leaf;
+        }
+
+        size_t half = size/2;
+        InternalNode* node = internalNodePool.create(parent, nullptr, nullptr, 0,
+                                                     std::pair<size_t, size_t>(row[half-1], row[half]), sites);
+        node->left = makeRow(row, half, node, last, dcel);
+        //The halfEdge of the breakpoint (a, b) is on the face of a, the left one
+        node->edge = dcel.addHalfEdgePair(getFace(row[half-1]), getFace(row[half]));
+        last->rightBreakpoint = node;
+        node->right = makeRow(row + half, size - half, node, last, dcel);
+        node->height = std::max(node->left->height, node->right->height) + 1;
+        return node;
+    }
+
     Leaf* Beachline::removePoint(const CircleEvent* cE, DCEL& dcel) {
-        std::pair<const cg3::Point2Dd*, const cg3::Point2Dd*> oldBreak, newBreak;
-        const Leaf* circleArc = cE->getArc();
+        std::pair<size_t, size_t> newBreak;
+        Leaf* circleArc = cE->getArc();
         Leaf* prev = circleArc->prev;
+        Leaf* next = circleArc->next;
         Node* otherChild;
         std::vector<HalfEdge>& edges = dcel.getHalfEdges();
         size_t parentEdge, otherEdge, newEdge;
-        bool isFirstBreakpoint;
 
+        //One of the two breakpoints of the arc is its parent, the other one is one of its ancestors
         InternalNode* _parent = static_cast<InternalNode*>(circleArc->parent);
-        InternalNode* _otherParent = static_cast<InternalNode*>(_parent->parent);
+        bool isFirstBreakpoint = _parent == circleArc->rightBreakpoint;
+        InternalNode* _otherParent = isFirstBreakpoint ? circleArc->leftBreakpoint : circleArc->rightBreakpoint;
+        assert(_otherParent);
 
-        //Update the tuples of breakpoints
-        if(_parent->breakpoint.first == circleArc->site) {
-            oldBreak = std::make_pair(circleArc->prev->site, circleArc->site);
-            newBreak = std::make_pair(circleArc->prev->site, _parent->breakpoint.second);
-            isFirstBreakpoint = true;
-        }
-        else {
-            oldBreak = std::make_pair(circleArc->site, circleArc->next->site);
-            newBreak = std::make_pair(_parent->breakpoint.first, circleArc->next->site);
-            isFirstBreakpoint = false;
-        }
+        //The breakpoint that remains is the one between prev and next
+        newBreak = std::make_pair(prev->site, next->site);
 
-        do {
-            assert(_otherParent);
-            if(_otherParent->breakpoint.first == oldBreak.first && _otherParent->breakpoint.second == oldBreak.second) {
-                break;
-            }
-            _otherParent = static_cast<InternalNode*>(_otherParent->parent);
-        } while(true); //While(true) -> not possible to not find oldBreak in ascendents
-
-        /*****/
-        /*****/
-        /* Lines of code copied from https://github.com/dkotsur/FortuneAlgo implementation
-         * Without these lines the algorithm doesn't work properly, but i changed the epsilon value
-         * With a value equals to 1.0 there are no artifacts in the diagram
-         */
-        double v1 = getValue(_parent), v2 = getValue(_otherParent);
-        if (fabs(v1 - v2) > 1.0) {
-            return nullptr;
-        }
-        /*****/
-        /*****/
-
-        size_t lastVertex = dcel.addVertex(Vertex(cE->getCircleCenter(), _parent->edge));
+        size_t lastVertex = dcel.addVertex(dcel.makeVertex(cE->getCircleCenter(), _parent->edge));
 
         parentEdge = _parent->edge;
         edges[_parent->edge].setOrigin(lastVertex);
         edges[_otherParent->edge].setOrigin(lastVertex);
-        _otherParent->breakpoint = newBreak;
+        _otherParent->setBreakpoint(newBreak, sites);
+        prev->rightBreakpoint = _otherParent;
+        next->leftBreakpoint = _otherParent;
         otherEdge = _otherParent->edge;
 
-        //Create new vertex and connect halfEdges to it
-        size_t lastIndex = dcel.addHalfEdge(Voronoi::HalfEdge());
-        edges[lastIndex].setTwin(lastIndex+1);
+        //Create new vertex and connect halfEdges to it, the new breakpoint is (prev, next)
+        size_t lastIndex = dcel.addHalfEdgePair(getFace(next->site), getFace(prev->site));
         edges[lastIndex].setOrigin(lastVertex);
-        dcel.addHalfEdge(Voronoi::HalfEdge());
-        edges[lastIndex+1].setTwin(lastIndex);
         _otherParent->edge = lastIndex+1;
         newEdge = _otherParent->edge;
 
-        //Connect next and prev halfEdges
-        if(isFirstBreakpoint) {
-            edges[parentEdge].setPrev(edges[otherEdge].getTwinID());
-            edges[edges[otherEdge].getTwinID()].setNext(parentEdge);
-            edges[otherEdge].setPrev(edges[newEdge].getTwinID());
-            edges[edges[newEdge].getTwinID()].setNext(otherEdge);
-            edges[newEdge].setPrev(edges[parentEdge].getTwinID());
-            edges[edges[parentEdge].getTwinID()].setNext(newEdge);
-        } else {
-            edges[parentEdge].setPrev(edges[newEdge].getTwinID());
-            edges[edges[newEdge].getTwinID()].setNext(parentEdge);
-            edges[otherEdge].setPrev(edges[parentEdge].getTwinID());
-            edges[edges[parentEdge].getTwinID()].setNext(otherEdge);
-            edges[newEdge].setPrev(edges[otherEdge].getTwinID());
-            edges[edges[otherEdge].getTwinID()].setNext(newEdge);
-        }
+        //Connect next and prev halfEdges around the new vertex, one pair for each of the three faces.
+        //The halfEdges of the breakpoints go from their end to their start, so the ones of (prev, arc) and (arc, next)
+        //leave the vertex and the one of (prev, next) reaches it
+        size_t leftEdge = isFirstBreakpoint ? otherEdge : parentEdge, rightEdge = isFirstBreakpoint ? parentEdge : otherEdge;
+        //face of arc
+        edges[rightEdge].setPrev(dcel.getTwinID(leftEdge));
+        edges[dcel.getTwinID(leftEdge)].setNext(rightEdge);
+        //face of prev
+        edges[leftEdge].setPrev(newEdge);
+        edges[newEdge].setNext(leftEdge);
+        //face of next
+        edges[dcel.getTwinID(newEdge)].setPrev(dcel.getTwinID(rightEdge));
+        edges[dcel.getTwinID(rightEdge)].setNext(dcel.getTwinID(newEdge));
 
         //Update the attributes of the other nodes (parent, left, right pointers)
         if(isRight(circleArc))
@@ -306,8 +311,8 @@ namespace Voronoi {
         else
             circleArc->parent->parent->left = otherChild;
 
-        delete circleArc->parent;
-        delete circleArc;
+        internalNodePool.destroy(_parent);
+        leafPool.destroy(circleArc);
 
         rebalanceCE(otherChild);
 
@@ -582,36 +587,90 @@ namespace Voronoi {
     }
 
     /**
-     * @brief Beachline::deleteNode deletes the subtree with node as root
+     * @brief Beachline::deleteNode deletes the subtree with node as root, giving its nodes back to the pools
      * @param node
      */
     void Beachline::deleteNode(Node *node) {
-        if(node) {
-            deleteNode(node->left);
-            deleteNode(node->right);
-            delete node;
+        if(node == root) {
+            clear();
+            return;
+        }
+        std::vector<Node*> stack;
+        if(node)
+            stack.push_back(node);
+        while(!stack.empty()) {
+            node = stack.back();
+            stack.pop_back();
+            if(isLeaf(node))
+                leafPool.destroy(static_cast<Leaf*>(node));
+            else {
+                stack.push_back(node->left);
+                stack.push_back(node->right);
+                internalNodePool.destroy(static_cast<InternalNode*>(node));
+            }
         }
     }
 
     /**
-     * @brief Beachline::copyBeachline Helper function for copy constructor
+     * @brief Beachline::copyBeachline Helper function for copy constructor, it copies the subtree with node as root
+     * and links the copied leaves with their prev and next pointers
      * @param node
-     * @return
+     * @return the root of the copy
      */
     Node* Beachline::copyBeachline(Node* const &node) {
-        Node* _copy = nullptr;
-        if(node) {
-            if(isLeaf(node)) {
-                Leaf* leaf = static_cast<Leaf*>(node);
-                return new Leaf(nullptr, nullptr, nullptr, leaf->site, leaf->circleEvent);
+        if(!node)
+            return nullptr;
+
+        //Pairs of (source node, copy), the visit is a preorder, so the leaves are copied from left to right.
+        //A pair (nullptr, copy) is visited between the two subtrees of copy, when copy is the breakpoint
+        //between the last leaf copied and the next one
+        std::vector<std::pair<const Node*, Node*>> stack;
+        Node* _copy = copyNode(node, nullptr);
+        Leaf* lastLeaf = nullptr;
+        InternalNode* lastBreakpoint = nullptr;
+        stack.push_back(std::make_pair(node, _copy));
+        while(!stack.empty()) {
+            const Node* source = stack.back().first;
+            Node* copy = stack.back().second;
+            stack.pop_back();
+            if(!source) {
+                lastBreakpoint = static_cast<InternalNode*>(copy);
+                lastLeaf->rightBreakpoint = lastBreakpoint;
+            } else if(isLeaf(source)) {
+                Leaf* leaf = static_cast<Leaf*>(copy);
+                leaf->prev = lastLeaf;
+                leaf->leftBreakpoint = lastBreakpoint;
+                if(lastLeaf)
+                    lastLeaf->next = leaf;
+                lastLeaf = leaf;
             } else {
-                InternalNode* intNode = static_cast<InternalNode*>(node);
-                return new InternalNode(nullptr, copyBeachline(intNode->left), copyBeachline(intNode->right), intNode->height, intNode->edge, intNode->breakpoint);
+                copy->left = copyNode(source->left, copy);
+                copy->right = copyNode(source->right, copy);
+                stack.push_back(std::make_pair(source->right, copy->right));
+                stack.push_back(std::make_pair(static_cast<const Node*>(nullptr), copy));
+                stack.push_back(std::make_pair(source->left, copy->left));
             }
         }
         return _copy;
     }
 
+    /**
+     * @brief Beachline::copyNode copies a single node, without its children
+     * @param node
+     * @param parent: parent of the copy
+     * @return the copy
+     */
+    Node* Beachline::copyNode(const Node* node, Node* parent) {
+        if(isLeaf(node)) {
+            const Leaf* leaf = static_cast<const Leaf*>(node);
+            return leafPool.create(parent, nullptr, nullptr, leaf->site, leaf->circleEvent);
+        } else {
+            const InternalNode* intNode = static_cast<const InternalNode*>(node);
+            return internalNodePool.create(parent, nullptr, nullptr, intNode->height, intNode->edge, intNode->breakpoint,
+                                           intNode->breakpointFunction);
+        }
+    }
+
     /**
      * @brief Beachline::min
      * @param node
@@ -674,26 +733,6 @@ namespace Voronoi {
         return static_cast<Leaf*>(parent);
     }
 
-    /**
-     * @brief Beachline::updateParent support function for the Beachline copy; this function updates parent, prev and next pointers
-     * @param node whose attributes is updated
-     */
-    void Beachline::updateAttributes(Node*& node) {
-        if(node->left) {
-            node->left->parent = node;
-            updateAttributes(node->left);
-        }
-        if(node->right) {
-            node->right->parent = node;
-            updateAttributes(node->right);
-        }
-        if(!node->left && !node->right) {
-            Leaf* leaf = static_cast<Leaf*>(node);
-            leaf->prev = prev(leaf);
-            leaf->next = next(leaf);
-        }
-    }
-
     /**
      * @brief Beachline::postorder Postorder visit of the Beachline
      * @param node: root of the tree to visit
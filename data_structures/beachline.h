@@ -4,7 +4,9 @@
 #include "dcel.h"
 #include "../mathVoronoi/parabola.h"
 #include "../mathVoronoi/circle.h"
-#include "./data_structures/event.h"
+#include "event.h"
+#include "pool.h"
+#include "sitespan.h"
 #include <queue>
 
 //#include <cg3/geometry/2d/point2d.h> INCLUDED BY PARABOLA.H, CIRCLE.H AND HALF_EDGE.H
@@ -27,51 +29,77 @@ namespace Voronoi {
     };
 
     /**
-     * @brief The InternalNode struct, the type for internal nodes
+     * @brief The InternalNode struct, the type for internal nodes.
+     * The breakpoint is the pair of the indices of its sites, it must be changed with setBreakpoint,
+     * which keeps its BreakpointFunction updated
      */
     struct InternalNode : Node {
         size_t edge;
-        std::pair<const cg3::Point2Dd*, const cg3::Point2Dd*> breakpoint;
+        std::pair<size_t, size_t> breakpoint;
+        BreakpointFunction breakpointFunction;
 
-        InternalNode(Node* parent, Node* left, Node* right, int height, std::pair<const cg3::Point2Dd*, const cg3::Point2Dd*> breakpoint) :
-            Node(parent, left, right, height), edge(std::numeric_limits<size_t>::max()), breakpoint(breakpoint) {}
-        InternalNode(Node* parent, Node* left, Node* right, int height, size_t edge, std::pair<const cg3::Point2Dd*, const cg3::Point2Dd*> breakpoint) :
-            Node(parent, left, right, height), edge(edge), breakpoint(breakpoint) {}
+        InternalNode(Node* parent, Node* left, Node* right, int height, std::pair<size_t, size_t> breakpoint, const SiteSpan& sites) :
+            Node(parent, left, right, height), edge(std::numeric_limits<size_t>::max()), breakpoint(breakpoint),
+            breakpointFunction(sites.x(breakpoint.first), sites.y(breakpoint.first), sites.x(breakpoint.second), sites.y(breakpoint.second)) {}
+        InternalNode(Node* parent, Node* left, Node* right, int height, size_t edge, std::pair<size_t, size_t> breakpoint,
+                     const BreakpointFunction& breakpointFunction) :
+            Node(parent, left, right, height), edge(edge), breakpoint(breakpoint), breakpointFunction(breakpointFunction) {}
+
+        void setBreakpoint(const std::pair<size_t, size_t>& newBreakpoint, const SiteSpan& sites) {
+            breakpoint = newBreakpoint;
+            breakpointFunction = BreakpointFunction(sites.x(breakpoint.first), sites.y(breakpoint.first),
+                                                    sites.x(breakpoint.second), sites.y(breakpoint.second));
+        }
     };
 
     /**
-     * @brief The Leaf struct, the type for leaves
+     * @brief The Leaf struct, the type for leaves.
+     * leftBreakpoint and rightBreakpoint are the internal nodes of the breakpoints (prev, this) and (this, next).
+     * The internal node between two consecutive leaves is always the same one, because the rotations
+     * keep the inorder sequence of the nodes, so they change only when the leaves are added or removed.
+     * site is the index of the site of the arc
      */
     struct Leaf : Node {
         Leaf* prev;
         Leaf* next;
+        InternalNode* leftBreakpoint;
+        InternalNode* rightBreakpoint;
 
-        const cg3::Point2Dd* site;
+        size_t site;
         CircleEvent* circleEvent;
 
-        Leaf(const cg3::Point2Dd* site) : Node(0), prev(nullptr), next(nullptr), site(site), circleEvent(nullptr) {}
-        Leaf(Node* parent, Leaf* prev, Leaf* next, const cg3::Point2Dd* site) :
-            Node(parent, nullptr, nullptr, 0), prev(prev), next(next), site(site), circleEvent(nullptr) {}
-        Leaf(Node* parent, Leaf* prev, Leaf* next, const cg3::Point2Dd* site, CircleEvent* circleEvent) :
-            Node(parent, nullptr, nullptr, 0), prev(prev), next(next), site(site), circleEvent(circleEvent) {}
+        Leaf(size_t site) : Node(0), prev(nullptr), next(nullptr),
+            leftBreakpoint(nullptr), rightBreakpoint(nullptr), site(site), circleEvent(nullptr) {}
+        Leaf(Node* parent, Leaf* prev, Leaf* next, size_t site) :
+            Node(parent, nullptr, nullptr, 0), prev(prev), next(next),
+            leftBreakpoint(nullptr), rightBreakpoint(nullptr), site(site), circleEvent(nullptr) {}
+        Leaf(Node* parent, Leaf* prev, Leaf* next, size_t site, CircleEvent* circleEvent) :
+            Node(parent, nullptr, nullptr, 0), prev(prev), next(next),
+            leftBreakpoint(nullptr), rightBreakpoint(nullptr), site(site), circleEvent(circleEvent) {}
     };
 
     /**
-     * @brief The Beachline class, implemented as a balanced BST
+     * @brief The Beachline class, implemented as a balanced BST.
+     * Leaves and internal nodes are allocated in pools owned by the Beachline: clear() releases all of them
+     * in O(1) and keeps the memory, so a Beachline can be reused for another run without new allocations
      * @class Beachline
      */
     class Beachline {
         public:
-            Beachline(double *sweepline) : root(nullptr), sweepline(sweepline) {}
+            Beachline(double *sweepline) : root(nullptr), sweepline(sweepline), firstFace(0) {}
             Beachline(const Beachline&);
             Beachline(Beachline&&);
             Beachline& operator=(Beachline);
             Beachline& operator=(Beachline&&);
             virtual ~Beachline();
 
-            CircleEvent* addPoint(const cg3::Point2Dd& p, Leaf*& newPoint, std::vector<Voronoi::HalfEdge>& edges);
+            CircleEvent* addPoint(size_t site, Leaf*& newPoint, DCEL& dcel);
+            void addFirstRow(const size_t* row, size_t size, DCEL& dcel);
             Leaf* removePoint(const CircleEvent* cE, DCEL& dcel);
             void clear();
+            void reserve(size_t nSites);
+            void setSites(const SiteSpan& sites, size_t firstFace);
+            const SiteSpan& getSites() const;
 
             Node* getRoot() const;
             bool isLeaf(const Node* node) const;
@@ -88,13 +116,25 @@ namespace Voronoi {
         private:
             Node* root;
             double* sweepline;
+            //the face of the site i is firstFace + i
+            SiteSpan sites;
+            size_t firstFace;
+
+            Pool<Leaf> leafPool;
+            Pool<InternalNode> internalNodePool;
+
+            //the path to the arc found by addPoint, kept between the calls so that they don't allocate
+            std::vector<std::pair<int,int>> balanceBuffer;
+            std::vector<int> pathBuffer;
 
             void swap(Beachline&);
 
             Node* findArc(const double x,
                           std::vector<std::pair<int,int>>& _balance, std::vector<int>& path, int& diff, int& last) const;
             double getValue(Node* _node) const;
-            CircleEvent* makeSubtree(Node*& node, const cg3::Point2Dd& p, std::vector<Voronoi::HalfEdge>& edges);
+            size_t getFace(size_t site) const;
+            CircleEvent* makeSubtree(Node*& node, size_t site, DCEL& dcel);
+            Node* makeRow(const size_t* row, size_t size, Node* parent, Leaf*& last, DCEL& dcel);
             void handleRotation(Node* arc,
                                 std::vector<std::pair<int,int>>& _balance, std::vector<int>& path, int diff, int last);
             void rebalanceCE(Node* node);
@@ -110,7 +150,7 @@ namespace Voronoi {
             void resetHeight(Node* node);
 
             Node* copyBeachline(Node* const &node);
-            void updateAttributes(Node*&);
+            Node* copyNode(const Node* node, Node* parent);
     };
 
     /**
@@ -171,11 +211,50 @@ namespace Voronoi {
     }
 
     /**
-     * @brief Beachline::clear clears the Beachline
+     * @brief Beachline::setSites sets the sites, the ones added to the Beachline are given by their index in them
+     * @param sites
+     * @param firstFace: the index of the face of the first site in the DCEL
+     */
+    inline void Beachline::setSites(const SiteSpan& sites, size_t firstFace) {
+        this->sites = sites;
+        this->firstFace = firstFace;
+    }
+
+    /**
+     * @brief Beachline::getSites
+     * @return the sites of the Beachline
+     */
+    inline const SiteSpan& Beachline::getSites() const {
+        return sites;
+    }
+
+    /**
+     * @brief Beachline::getFace
+     * @param site
+     * @return the index of the face of site in the DCEL
+     */
+    inline size_t Beachline::getFace(size_t site) const {
+        return firstFace + site;
+    }
+
+    /**
+     * @brief Beachline::clear clears the Beachline in O(1), the memory of the nodes is kept for reuse
+     * and the pointer to the sweepline is not changed
      */
     inline void Beachline::clear() {
-        deleteNode(root);
-        sweepline = nullptr;
+        leafPool.reset();
+        internalNodePool.reset();
+        root = nullptr;
+    }
+
+    /**
+     * @brief Beachline::reserve allocates the nodes of a beachline of nSites sites: each site adds at most two leaves
+     * and two internal nodes
+     * @param nSites
+     */
+    inline void Beachline::reserve(size_t nSites) {
+        leafPool.reserve(2*nSites);
+        internalNodePool.reserve(2*nSites);
     }
 
 }
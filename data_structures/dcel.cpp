@@ -1,23 +1,144 @@
 #include "dcel.h"
+#include <assert.h>
+#include <algorithm>
 
 namespace Voronoi {
     /**
      * @brief DCEL::addVertex
      * @param V: vertex to add to the DCEL
-     * @return the index where the vertex is stored
+     * @return the index where the vertex is stored, the slot of a removed vertex if there is one
      */
     size_t DCEL::addVertex(const Voronoi::Vertex &V) {
+        if(!freeVertexs.empty()) {
+            size_t index = freeVertexs.back();
+            freeVertexs.pop_back();
+            vertexs[index] = V;
+            return index;
+        }
         vertexs.push_back(V);
         return vertexs.size()-1;
     }
 
     /**
-     * @brief DCEL::addHalfEdge
-     * @param HE: halfEdge to add to the DCEL
-     * @return the index where the halfEdge is stored
+     * @brief DCEL::removeVertex leaves the vertex without incident halfEdge and makes its slot available
+     * for the next vertex added
+     * @param vertexIndex: a vertex not used by any halfEdge, removed only once
      */
-    size_t DCEL::addHalfEdge(const Voronoi::HalfEdge &HE) {
-        halfEdges.push_back(HE);
-        return halfEdges.size()-1;
+    void DCEL::removeVertex(size_t vertexIndex) {
+        vertexs[vertexIndex].setIncidEdge(std::numeric_limits<size_t>::max());
+        freeVertexs.push_back(vertexIndex);
+    }
+
+    /**
+     * @brief DCEL::addHalfEdgePair adds two twin halfEdges, with no origin, next and prev.
+     * A face without an incident halfEdge gets the new one
+     * @param face: the face of the first halfEdge, std::numeric_limits<size_t>::max() for no face
+     * @param twinFace: the face of the second halfEdge, std::numeric_limits<size_t>::max() for no face
+     * @return the index where the first halfEdge is stored, its twin is the next one.
+     * The slots of a removed pair are used if there is one
+     */
+    size_t DCEL::addHalfEdgePair(size_t face, size_t twinFace) {
+        size_t index;
+        if(!freeHalfEdgePairs.empty()) {
+            index = freeHalfEdgePairs.back();
+            freeHalfEdgePairs.pop_back();
+            halfEdges[index] = HalfEdge();
+            halfEdges[index+1] = HalfEdge();
+        } else {
+            index = halfEdges.size();
+            assert(index % 2 == 0);
+            assert(index + 1 < std::numeric_limits<DCELIndex>::max());
+            halfEdges.resize(index + 2);
+        }
+#ifndef VORONOI_COMPACT_DCEL
+        halfEdges[index].setTwin(index+1);
+        halfEdges[index+1].setTwin(index);
+#endif
+        halfEdges[index].setFace(face);
+        halfEdges[index+1].setFace(twinFace);
+        if(face != std::numeric_limits<size_t>::max() && faces[face].getIncidEdgeID() == std::numeric_limits<size_t>::max())
+            faces[face].setIncidEdge(index);
+        if(twinFace != std::numeric_limits<size_t>::max() && faces[twinFace].getIncidEdgeID() == std::numeric_limits<size_t>::max())
+            faces[twinFace].setIncidEdge(index+1);
+        return index;
+    }
+
+    /**
+     * @brief DCEL::removeHalfEdgePair leaves the halfEdge and its twin without origin, next and prev and makes
+     * their slots available for the next pair added. Their faces are kept
+     * @param halfEdgeIndex: one of the two halfEdges, not used by any other element, removed only once
+     */
+    void DCEL::removeHalfEdgePair(size_t halfEdgeIndex) {
+        size_t index = halfEdgeIndex - halfEdgeIndex % 2;
+        for(size_t e = index; e < index + 2; e++) {
+            halfEdges[e].setOrigin(std::numeric_limits<size_t>::max());
+            halfEdges[e].setNext(std::numeric_limits<size_t>::max());
+            halfEdges[e].setPrev(std::numeric_limits<size_t>::max());
+        }
+        freeHalfEdgePairs.push_back(index);
+    }
+
+    /**
+     * @brief DCEL::addFace
+     * @param F: face to add to the DCEL
+     * @return the index where the face is stored
+     */
+    size_t DCEL::addFace(const Voronoi::Face &F) {
+        faces.push_back(F);
+        return faces.size()-1;
+    }
+
+    /**
+     * @brief DCEL::reuseFace
+     * @param F: face to add to the DCEL
+     * @return the index where the face is stored: the slot of a removed face if there is one, otherwise the next one
+     */
+    size_t DCEL::reuseFace(const Voronoi::Face &F) {
+        if(freeFaces.empty())
+            return addFace(F);
+        size_t index = freeFaces.back();
+        freeFaces.pop_back();
+        faces[index] = F;
+        coincidentFaces[index] = index;
+        return index;
+    }
+
+    /**
+     * @brief DCEL::removeFace takes the face out of its ring of coincident faces and makes its slot available
+     * for the next face added by reuseFace
+     * @param faceIndex: a face without a cell, removed only once
+     */
+    void DCEL::removeFace(size_t faceIndex) {
+        unlinkCoincidentFace(faceIndex);
+        for(size_t f = coincidentFaces.size(); f <= faceIndex; f++)
+            coincidentFaces.push_back(f);
+        coincidentFaces[faceIndex] = std::numeric_limits<size_t>::max();
+        freeFaces.push_back(faceIndex);
+    }
+
+    /**
+     * @brief DCEL::linkCoincidentFaces adds a face to the ring of the faces with the same site of another one
+     * @param faceIndex: a face of the ring, e.g. the one with the cell
+     * @param coincidentFace: a face with the same site, without a cell and not in a ring
+     */
+    void DCEL::linkCoincidentFaces(size_t faceIndex, size_t coincidentFace) {
+        for(size_t f = coincidentFaces.size(); f <= std::max(faceIndex, coincidentFace); f++)
+            coincidentFaces.push_back(f);
+        coincidentFaces[coincidentFace] = coincidentFaces[faceIndex];
+        coincidentFaces[faceIndex] = coincidentFace;
+    }
+
+    /**
+     * @brief DCEL::unlinkCoincidentFace removes a face from the ring of the faces with its site, the face is left alone
+     * @param faceIndex
+     */
+    void DCEL::unlinkCoincidentFace(size_t faceIndex) {
+        if(faceIndex >= coincidentFaces.size() || coincidentFaces[faceIndex] == std::numeric_limits<size_t>::max())
+            return;
+        size_t previous = faceIndex;
+        while(coincidentFaces[previous] != faceIndex)
+            previous = coincidentFaces[previous];
+        coincidentFaces[previous] = coincidentFaces[faceIndex];
+        coincidentFaces[faceIndex] = faceIndex;
     }
 }
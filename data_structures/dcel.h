@@ -1,16 +1,28 @@
 #ifndef DCEL_H
 #define DCEL_H
 
+#include <limits>
 #include <vector>
 
+#include <cg3/geometry/2d/bounding_box2d.h>
+
 #include "vertex.h"
 #include "half_edge.h"
+#include "face.h"
 
 namespace Voronoi {
 
     /**
       * @class DCEL
-      * @brief The DCEL class models a doubly connected edge list
+      * @brief The DCEL class models a doubly connected edge list.
+      * HalfEdges are added in pairs of twins, the twin of the halfEdge i is i^1.
+      * The faces are the cells of the sites, the face i is the cell of the i-th site given to fortuneAlgorithm.
+      * Defining VORONOI_COMPACT_DCEL at compile time the DCEL uses 32-bit indices, implicit twins and plain vertexs.
+      * With VORONOI_FLOAT_COORDINATES the vertexs store their coordinates relative to the origin of the DCEL
+      * (the center of the box of the first diagram stored), so getVertexCoordinates and makeVertex convert them.
+      * The slots of the removed vertexs and pairs of halfEdges are reused by the next additions, the ones of the removed faces
+      * by reuseFace (addFace always appends, the engines need the faces in the order of their sites).
+      * The faces of equal sites form a ring through getCoincidentFace, only one of them has the cell of the site
     */
     class DCEL {
         public:
@@ -20,44 +32,160 @@ namespace Voronoi {
 
             //vertexs methods
             std::vector<Vertex>& getVertexs();
+            const std::vector<Vertex>& getVertexs() const;
             const Voronoi::HalfEdge& getIncidEdge(size_t vertexIndex) const;
             size_t addVertex(const Voronoi::Vertex& V);
+            void removeVertex(size_t vertexIndex);
+            cg3::Point2Dd getVertexCoordinates(size_t vertexIndex) const;
+            void setVertexCoordinates(size_t vertexIndex, const cg3::Point2Dd& coordinates);
+            Vertex makeVertex(const cg3::Point2Dd& coordinates) const;
+            Vertex makeVertex(const cg3::Point2Dd& coordinates, size_t incidEdge) const;
+            const cg3::Point2Dd& getOrigin() const;
+            void setOrigin(const cg3::Point2Dd& origin);
+            void fitOrigin(const cg3::BoundingBox2D& boundingBox);
 
             //halfedges methods
             std::vector<HalfEdge>& getHalfEdges();
+            const std::vector<HalfEdge>& getHalfEdges() const;
             const Voronoi::Vertex& getHEOrigin(size_t halfEdgeIndex) const;
             const Voronoi::HalfEdge& getHETwin(size_t halfEdgeIndex) const;
+            size_t getTwinID(size_t halfEdgeIndex) const;
             const Voronoi::HalfEdge& getHENext(size_t halfEdgeIndex) const;
             const Voronoi::HalfEdge& getHEPrev(size_t halfEdgeIndex) const;
-            size_t addHalfEdge(const Voronoi::HalfEdge& HE);
+            const Voronoi::Face& getHEFace(size_t halfEdgeIndex) const;
+            size_t addHalfEdgePair(size_t face, size_t twinFace);
+            void removeHalfEdgePair(size_t halfEdgeIndex);
+
+            //faces methods
+            std::vector<Face>& getFaces();
+            const std::vector<Face>& getFaces() const;
+            const Voronoi::HalfEdge& getFaceEdge(size_t faceIndex) const;
+            size_t addFace(const Voronoi::Face& F);
+            size_t reuseFace(const Voronoi::Face& F);
+            void removeFace(size_t faceIndex);
+            bool isFaceRemoved(size_t faceIndex) const;
+            size_t getCoincidentFace(size_t faceIndex) const;
+            void linkCoincidentFaces(size_t faceIndex, size_t coincidentFace);
+            void unlinkCoincidentFace(size_t faceIndex);
         protected:
+            cg3::Point2Dd origin;
             std::vector<Vertex> vertexs;
             std::vector<HalfEdge> halfEdges;
+            std::vector<Face> faces;
+            std::vector<size_t> freeVertexs;
+            std::vector<size_t> freeHalfEdgePairs;
+            std::vector<size_t> freeFaces;
+            std::vector<size_t> coincidentFaces;
     };
 
     inline void DCEL::clear() {
         vertexs.clear();
         halfEdges.clear();
+        faces.clear();
+        freeVertexs.clear();
+        freeHalfEdgePairs.clear();
+        freeFaces.clear();
+        coincidentFaces.clear();
     }
 
     inline std::vector<Vertex>& DCEL::getVertexs() {
         return vertexs;
     }
 
+    inline const std::vector<Vertex>& DCEL::getVertexs() const {
+        return vertexs;
+    }
+
     inline const Voronoi::HalfEdge& DCEL::getIncidEdge(size_t vertexIndex) const {
         return halfEdges[vertexs[vertexIndex].getIncidEdgeID()];
     }
 
+    /**
+     * @brief DCEL::getVertexCoordinates the coordinates of the vertex, with the origin added back to the stored ones
+     */
+    inline cg3::Point2Dd DCEL::getVertexCoordinates(size_t vertexIndex) const {
+#ifdef VORONOI_FLOAT_COORDINATES
+        return origin + vertexs[vertexIndex].getCoordinates();
+#else
+        return vertexs[vertexIndex].getCoordinates();
+#endif
+    }
+
+    inline void DCEL::setVertexCoordinates(size_t vertexIndex, const cg3::Point2Dd& coordinates) {
+#ifdef VORONOI_FLOAT_COORDINATES
+        vertexs[vertexIndex].setCoordinates(coordinates - origin);
+#else
+        vertexs[vertexIndex].setCoordinates(coordinates);
+#endif
+    }
+
+    /**
+     * @brief DCEL::makeVertex a vertex at coordinates to be stored in this DCEL, relative to its origin
+     */
+    inline Vertex DCEL::makeVertex(const cg3::Point2Dd& coordinates) const {
+#ifdef VORONOI_FLOAT_COORDINATES
+        return Vertex(coordinates - origin);
+#else
+        return Vertex(coordinates);
+#endif
+    }
+
+    inline Vertex DCEL::makeVertex(const cg3::Point2Dd& coordinates, size_t incidEdge) const {
+#ifdef VORONOI_FLOAT_COORDINATES
+        return Vertex(coordinates - origin, incidEdge);
+#else
+        return Vertex(coordinates, incidEdge);
+#endif
+    }
+
+    inline const cg3::Point2Dd& DCEL::getOrigin() const {
+        return origin;
+    }
+
+    /**
+     * @brief DCEL::setOrigin sets the point the coordinates of the vertexs are stored relative to, the DCEL must have no vertexs.
+     * Without VORONOI_FLOAT_COORDINATES the origin is not used and should stay (0, 0)
+     */
+    inline void DCEL::setOrigin(const cg3::Point2Dd& origin) {
+        this->origin = origin;
+    }
+
+    /**
+     * @brief DCEL::fitOrigin moves the origin to the center of the box if the DCEL has no vertexs yet,
+     * so that float coordinates keep their precision far from (0, 0). Called by the engines before they add a diagram
+     */
+#ifdef VORONOI_FLOAT_COORDINATES
+    inline void DCEL::fitOrigin(const cg3::BoundingBox2D& boundingBox) {
+        if(vertexs.empty())
+            origin = (boundingBox.min() + boundingBox.max())/2;
+    }
+#else
+    inline void DCEL::fitOrigin(const cg3::BoundingBox2D&) {
+    }
+#endif
+
     inline std::vector<HalfEdge>& DCEL::getHalfEdges() {
         return halfEdges;
     }
 
+    inline const std::vector<HalfEdge>& DCEL::getHalfEdges() const {
+        return halfEdges;
+    }
+
     inline const Voronoi::Vertex& DCEL::getHEOrigin(size_t halfEdgeIndex) const {
         return vertexs[halfEdges[halfEdgeIndex].getOriginID()];
     }
 
     inline const Voronoi::HalfEdge& DCEL::getHETwin(size_t halfEdgeIndex) const {
-        return halfEdges[halfEdges[halfEdgeIndex].getTwinID()];
+        return halfEdges[getTwinID(halfEdgeIndex)];
+    }
+
+    inline size_t DCEL::getTwinID(size_t halfEdgeIndex) const {
+#ifdef VORONOI_COMPACT_DCEL
+        return halfEdgeIndex ^ 1;
+#else
+        return halfEdges[halfEdgeIndex].getTwinID();
+#endif
     }
 
     inline const Voronoi::HalfEdge& DCEL::getHENext(size_t halfEdgeIndex) const {
@@ -67,6 +195,38 @@ namespace Voronoi {
     inline const Voronoi::HalfEdge& DCEL::getHEPrev(size_t halfEdgeIndex) const {
         return halfEdges[halfEdges[halfEdgeIndex].getPrevID()];
     }
+
+    inline const Voronoi::Face& DCEL::getHEFace(size_t halfEdgeIndex) const {
+        return faces[halfEdges[halfEdgeIndex].getFaceID()];
+    }
+
+    inline std::vector<Face>& DCEL::getFaces() {
+        return faces;
+    }
+
+    inline const std::vector<Face>& DCEL::getFaces() const {
+        return faces;
+    }
+
+    inline const Voronoi::HalfEdge& DCEL::getFaceEdge(size_t faceIndex) const {
+        return halfEdges[faces[faceIndex].getIncidEdgeID()];
+    }
+
+    /**
+     * @brief DCEL::isFaceRemoved true if the face was removed by removeFace and its slot not reused yet
+     */
+    inline bool DCEL::isFaceRemoved(size_t faceIndex) const {
+        return faceIndex < coincidentFaces.size() && coincidentFaces[faceIndex] == std::numeric_limits<size_t>::max();
+    }
+
+    /**
+     * @brief DCEL::getCoincidentFace the next face in the ring of the faces with the same site, the face itself if its site
+     * is not repeated, std::numeric_limits<size_t>::max() if the face is removed.
+     * Walking the ring from a face without a cell leads to the one with the cell
+     */
+    inline size_t DCEL::getCoincidentFace(size_t faceIndex) const {
+        return faceIndex < coincidentFaces.size() ? coincidentFaces[faceIndex] : faceIndex;
+    }
 }
 
 #endif // DCEL_H
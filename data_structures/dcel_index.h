@@ -0,0 +1,38 @@
+#ifndef DCEL_INDEX_H
+#define DCEL_INDEX_H
+
+#include <stddef.h> //for size_t
+#include <limits>
+
+#ifdef VORONOI_COMPACT_DCEL
+#include <stdint.h>
+#endif
+
+namespace Voronoi {
+    /**
+     * @brief DCELIndex, the type of the indices stored in vertexs and halfEdges.
+     * With VORONOI_COMPACT_DCEL defined indices are 32-bit, so a diagram can't have more than 2^32 - 2 halfEdges
+     */
+#ifdef VORONOI_COMPACT_DCEL
+    typedef uint32_t DCELIndex;
+#else
+    typedef size_t DCELIndex;
+#endif
+
+    /**
+     * @brief toDCELIndex, conversion of an index before it is stored, the "empty" reference is kept
+     */
+    inline DCELIndex toDCELIndex(size_t index) {
+        return static_cast<DCELIndex>(index);
+    }
+
+    /**
+     * @brief fromDCELIndex, conversion of a stored index, the "empty" reference becomes std::numeric_limits<size_t>::max()
+     */
+    inline size_t fromDCELIndex(DCELIndex index) {
+        return index == std::numeric_limits<DCELIndex>::max() ? std::numeric_limits<size_t>::max() : index;
+    }
+
+}
+
+#endif // DCEL_INDEX_H
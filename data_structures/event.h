@@ -2,61 +2,48 @@
 #define EVENT_H
 
 #include <cg3/geometry/2d/point2d.h>
+#include <limits>
 
 namespace Voronoi {
 
     struct Leaf;
-    class Event {
-
-        public:
-            typedef enum {SITE, CIRCLE, FALSE} EventType;
-
-            virtual ~Event();
-
-            EventType getType() const;
-
-            void setType(const EventType eT);
-            virtual const cg3::Point2Dd& getPoint() const = 0;
-
-        protected:
-            Event(const EventType type) : type(type) {}
-        private :
-            //Event attributes
-            EventType type;
-    };
-
-    class SiteEvent : public Event {
-        public:
-            SiteEvent(const cg3::Point2Dd& point) : Event(EventType::SITE), point(point) {}
-
-            const cg3::Point2Dd& getPoint() const;
-        private:
-            const cg3::Point2Dd& point;
-    };
-
-    class CircleEvent : public Event {
+    class EventQueue;
+
+    /**
+     * @brief The CircleEvent class, the only kind of event kept in the EventQueue:
+     * site events are consumed directly from the sorted sequence of input points.
+     * The event point is the bottom of the circle, below its center: only the center and the y of the event are stored,
+     * as plain coordinates
+     */
+    class CircleEvent {
         public:
             CircleEvent (const cg3::Point2Dd point, const cg3::Point2Dd center, Leaf* arc):
-                Event(EventType::CIRCLE), point(point), center(center), arc(arc) {}
+                centerX(center.x()), centerY(center.y()), y(point.y()), arc(arc), handle(std::numeric_limits<size_t>::max()) {}
 
-            const cg3::Point2Dd& getPoint() const;
-            const cg3::Point2Dd& getCircleCenter() const;
-            const Leaf* getArc() const;
+            cg3::Point2Dd getPoint() const;
+            cg3::Point2Dd getCircleCenter() const;
+            double getY() const;
+            Leaf* getArc() const;
+            size_t getHandle() const;
         private:
-            const cg3::Point2Dd point;
-            const cg3::Point2Dd center;
+            friend class EventQueue;
+
+            const double centerX, centerY;
+            const double y;
             Leaf* arc;
+            //position of the event in the EventQueue, max value if it is not queued
+            size_t handle;
     };
 
-    inline Event::EventType Event::getType() const { return type; }
-    inline const cg3::Point2Dd& CircleEvent::getCircleCenter() const { return center; }
-    inline const Leaf* CircleEvent::getArc() const { return arc; }
-
-    inline void Event::setType(const EventType eT) { type = eT; }
+    inline cg3::Point2Dd CircleEvent::getPoint() const { return cg3::Point2Dd(centerX, y); }
+    inline cg3::Point2Dd CircleEvent::getCircleCenter() const { return cg3::Point2Dd(centerX, centerY); }
+    inline double CircleEvent::getY() const { return y; }
+    inline Leaf* CircleEvent::getArc() const { return arc; }
+    inline size_t CircleEvent::getHandle() const { return handle; }
 
     struct EventComparator {
-        bool operator()(const Event* e1, const Event* e2) {
-            return e1->getPoint().y() < e2->getPoint().y();
+        bool operator()(const CircleEvent* e1, const CircleEvent* e2) {
+            return e1->getY() < e2->getY();
         }
     };
 
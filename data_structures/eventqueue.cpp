@@ -0,0 +1,139 @@
+#include "eventqueue.h"
+#include <assert.h>
+#include <algorithm>
+
+#define EVENTQUEUE_ARITY 4
+
+namespace Voronoi {
+
+    /**
+     * @brief EventQueue::push creates a circle event and adds it to the queue
+     * @param point: the lowest point of the circle, it gives the priority of the event
+     * @param center: the center of the circle
+     * @param arc: the arc that disappears with the event
+     * @return the new event
+     */
+    CircleEvent* EventQueue::push(const cg3::Point2Dd& point, const cg3::Point2Dd& center, Leaf* arc) {
+        CircleEvent* e = events.create(point, center, arc);
+        heap.push_back(e);
+        e->handle = heap.size()-1;
+        siftUp(heap.size()-1);
+
+        statistics.pushes++;
+        if(heap.size() > statistics.maxSize)
+            statistics.maxSize = heap.size();
+        return e;
+    }
+
+    /**
+     * @brief EventQueue::pop removes the event with the highest y-coordinate from the queue,
+     * the event stays alive until release() is called on it
+     * @return the removed event
+     */
+    CircleEvent* EventQueue::pop() {
+        assert(!heap.empty());
+        CircleEvent* e = heap.front();
+        CircleEvent* last = heap.back();
+        heap.pop_back();
+        if(!heap.empty()) {
+            place(last, 0);
+            siftDown(0);
+        }
+        e->handle = std::numeric_limits<size_t>::max();
+
+        statistics.pops++;
+        return e;
+    }
+
+    /**
+     * @brief EventQueue::remove removes a queued event from any position of the heap and deletes it
+     * @param e: the event to remove
+     */
+    void EventQueue::remove(CircleEvent* e) {
+        assert(contains(e));
+        size_t index = e->handle;
+        CircleEvent* last = heap.back();
+        heap.pop_back();
+        if(index < heap.size()) {
+            place(last, index);
+            //the moved event can be either higher or lower than the removed one
+            if(index > 0 && EventComparator()(heap[(index-1)/EVENTQUEUE_ARITY], last))
+                siftUp(index);
+            else
+                siftDown(index);
+        }
+        events.destroy(e);
+
+        statistics.removals++;
+    }
+
+    /**
+     * @brief EventQueue::release deletes an event returned by pop()
+     * @param e
+     */
+    void EventQueue::release(CircleEvent* e) {
+        assert(!contains(e));
+        events.destroy(e);
+    }
+
+    /**
+     * @brief EventQueue::reserve
+     * @param capacity: number of events that can be queued without reallocations
+     */
+    void EventQueue::reserve(size_t capacity) {
+        heap.reserve(capacity);
+        events.reserve(capacity);
+    }
+
+    /**
+     * @brief EventQueue::clear deletes all the events, queued or not, in O(1) and resets the statistics.
+     * The memory is kept for the next events
+     */
+    void EventQueue::clear() {
+        heap.clear();
+        events.reset();
+        statistics = EventQueueStatistics();
+    }
+
+    /**
+     * @brief EventQueue::siftUp moves the event in position index towards the root until the heap property holds
+     * @param index
+     */
+    void EventQueue::siftUp(size_t index) {
+        CircleEvent* e = heap[index];
+        while(index > 0) {
+            size_t parent = (index-1)/EVENTQUEUE_ARITY;
+            if(!EventComparator()(heap[parent], e))
+                break;
+            place(heap[parent], index);
+            index = parent;
+        }
+        place(e, index);
+    }
+
+    /**
+     * @brief EventQueue::siftDown moves the event in position index towards the leaves until the heap property holds
+     * @param index
+     */
+    void EventQueue::siftDown(size_t index) {
+        CircleEvent* e = heap[index];
+        size_t size = heap.size();
+        while(true) {
+            size_t first = index*EVENTQUEUE_ARITY + 1;
+            if(first >= size)
+                break;
+            size_t last = std::min(first + EVENTQUEUE_ARITY, size);
+            size_t best = first;
+            for(size_t child = first+1; child < last; child++) {
+                if(EventComparator()(heap[best], heap[child]))
+                    best = child;
+            }
+            if(!EventComparator()(e, heap[best]))
+                break;
+            place(heap[best], index);
+            index = best;
+        }
+        place(e, index);
+    }
+
+}
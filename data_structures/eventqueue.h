@@ -0,0 +1,85 @@
+#ifndef EVENTQUEUE_H
+#define EVENTQUEUE_H
+
+#include <vector>
+#include "event.h"
+#include "pool.h"
+
+namespace Voronoi {
+
+    /**
+     * @brief The EventQueueStatistics struct, counters of the work done by an EventQueue
+     */
+    struct EventQueueStatistics {
+        size_t pushes;
+        size_t pops;
+        //events deleted in place, each of them would have been a stale pop with a tombstone queue
+        size_t removals;
+        size_t maxSize;
+
+        EventQueueStatistics() : pushes(0), pops(0), removals(0), maxSize(0) {}
+    };
+
+    /**
+     * @brief The EventQueue class, an addressable 4-ary max-heap of circle events ordered by y-coordinate.
+     * Each queued event stores its position in the heap, so it can be removed in O(log n)
+     * as soon as it becomes a false alarm instead of waiting to be popped.
+     * The queue owns the events, which are allocated in a Pool: clear() releases all of them at once
+     * and keeps the memory for the next run.
+     * @class EventQueue
+     */
+    class EventQueue {
+        public:
+            EventQueue() = default;
+
+            CircleEvent* push(const cg3::Point2Dd& point, const cg3::Point2Dd& center, Leaf* arc);
+            CircleEvent* pop();
+            void remove(CircleEvent* e);
+            void release(CircleEvent* e);
+            void reserve(size_t capacity);
+            void clear();
+
+            CircleEvent* top() const;
+            bool empty() const;
+            size_t size() const;
+            bool contains(const CircleEvent* e) const;
+            const EventQueueStatistics& getStatistics() const;
+
+        private:
+            std::vector<CircleEvent*> heap;
+            Pool<CircleEvent> events;
+            EventQueueStatistics statistics;
+
+            void siftUp(size_t index);
+            void siftDown(size_t index);
+            void place(CircleEvent* e, size_t index);
+    };
+
+    inline CircleEvent* EventQueue::top() const {
+        return heap.front();
+    }
+
+    inline bool EventQueue::empty() const {
+        return heap.empty();
+    }
+
+    inline size_t EventQueue::size() const {
+        return heap.size();
+    }
+
+    inline bool EventQueue::contains(const CircleEvent* e) const {
+        return e->handle < heap.size() && heap[e->handle] == e;
+    }
+
+    inline const EventQueueStatistics& EventQueue::getStatistics() const {
+        return statistics;
+    }
+
+    inline void EventQueue::place(CircleEvent* e, size_t index) {
+        heap[index] = e;
+        e->handle = index;
+    }
+
+}
+
+#endif // EVENTQUEUE_H
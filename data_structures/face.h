@@ -0,0 +1,41 @@
+#ifndef FACE_H
+#define FACE_H
+
+#include <cg3/geometry/2d/point2d.h>
+#include "dcel_index.h"
+
+namespace Voronoi {
+    /**
+     * @class Face
+     * @brief The Face class models a DCEL Face, the cell of a site of the diagram.
+     * The cell is on the left of its halfEdges, so walking the next pointers the boundary is visited counterclockwise.
+     * With VORONOI_COMPACT_DCEL defined it stores the plain coordinates of the site, as Vertex does
+     */
+    class Face {
+        public:
+            Face();
+            Face(const cg3::Point2Dd& site);
+            Face(const cg3::Point2Dd& site, const size_t incidEdge);
+
+#ifdef VORONOI_COMPACT_DCEL
+            cg3::Point2Dd getSite() const;
+#else
+            const cg3::Point2Dd& getSite() const;
+#endif
+            size_t getIncidEdgeID() const;
+            void setIncidEdge(const size_t incidEdge);
+            void setSite(const cg3::Point2Dd& p);
+    private:
+#ifdef VORONOI_COMPACT_DCEL
+            double _x, _y;
+#else
+            cg3::Point2Dd _site;
+#endif
+            DCELIndex _incidEdge;
+    };
+
+}
+
+#include "face.tpp"
+
+#endif // FACE_H
@@ -0,0 +1,52 @@
+#include "face.h"
+
+namespace Voronoi {
+
+#ifdef VORONOI_COMPACT_DCEL
+inline Face::Face() : _x(0), _y(0), _incidEdge(std::numeric_limits<DCELIndex>::max()) {
+}
+
+inline Face::Face(const cg3::Point2Dd& site): _x(site.x()), _y(site.y()), _incidEdge(std::numeric_limits<DCELIndex>::max()) {
+}
+
+inline Face::Face(const cg3::Point2Dd& site, const size_t incidEdge) :
+    _x(site.x()), _y(site.y()), _incidEdge(toDCELIndex(incidEdge)) {
+}
+
+inline cg3::Point2Dd Face::getSite() const {
+    return cg3::Point2Dd(_x, _y);
+}
+
+inline void Face::setSite(const cg3::Point2Dd &p) {
+    _x = p.x();
+    _y = p.y();
+}
+#else
+inline Face::Face() : _site(), _incidEdge(std::numeric_limits<DCELIndex>::max()) {
+}
+
+inline Face::Face(const cg3::Point2Dd& site): _site(site), _incidEdge(std::numeric_limits<DCELIndex>::max()) {
+}
+
+inline Face::Face(const cg3::Point2Dd& site, const size_t incidEdge) :
+    _site(site), _incidEdge(incidEdge) {
+}
+
+inline const cg3::Point2Dd& Face::getSite() const {
+    return _site;
+}
+
+inline void Face::setSite(const cg3::Point2Dd &p) {
+    _site = p;
+}
+#endif
+
+inline size_t Face::getIncidEdgeID() const {
+    return fromDCELIndex(_incidEdge);
+}
+
+inline void Face::setIncidEdge(size_t incidEdge) {
+    _incidEdge = toDCELIndex(incidEdge);
+}
+
+}
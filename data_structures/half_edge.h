@@ -1,34 +1,46 @@
 #ifndef HALF_EDGE_H
 #define HALF_EDGE_H
 
-#include <stddef.h> //for size_t
-#include <limits>
+#include "dcel_index.h"
 
 namespace Voronoi {
     /**
      * @class Half_Edge
-     * @brief The HalfEdge class
+     * @brief The HalfEdge class. The face of a halfEdge is the cell on its left.
+     * With VORONOI_COMPACT_DCEL defined the twin is not stored: halfEdges are always added in pairs,
+     * so the twin of the halfEdge i is i^1 and it is given by DCEL::getTwinID
      */
     class HalfEdge {
         public:
             HalfEdge();
+#ifdef VORONOI_COMPACT_DCEL
+            HalfEdge(size_t origin, size_t next, size_t prev);
+#else
             HalfEdge(size_t origin, size_t twin,
                      size_t next, size_t prev);
+#endif
 
             size_t getOriginID() const;
-            size_t getTwinID() const;
             size_t getNextID() const;
             size_t getPrevID() const;
+            size_t getFaceID() const;
             void setOrigin(size_t origin);
-            void setTwin(size_t twin);
             void setNext(size_t next);
             void setPrev(size_t prev);
+            void setFace(size_t face);
+#ifndef VORONOI_COMPACT_DCEL
+            size_t getTwinID() const;
+            void setTwin(size_t twin);
+#endif
 
         private:
-            size_t _origin;
-            size_t _twin;
-            size_t _next;
-            size_t _prev;
+            DCELIndex _origin;
+#ifndef VORONOI_COMPACT_DCEL
+            DCELIndex _twin;
+#endif
+            DCELIndex _next;
+            DCELIndex _prev;
+            DCELIndex _face;
     };
 
 }
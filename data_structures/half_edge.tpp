@@ -1,45 +1,66 @@
 #include "half_edge.h"
 
 namespace Voronoi {
-//IDs are set to the maximum value that a size_t could contain, it represents an "empty" reference
-inline HalfEdge::HalfEdge() : _origin(std::numeric_limits<size_t>::max()), _twin(std::numeric_limits<size_t>::max()),
-    _next(std::numeric_limits<size_t>::max()), _prev(std::numeric_limits<size_t>::max()) {
+//IDs are set to the maximum value that a DCELIndex could contain, it represents an "empty" reference
+#ifdef VORONOI_COMPACT_DCEL
+inline HalfEdge::HalfEdge() : _origin(std::numeric_limits<DCELIndex>::max()),
+    _next(std::numeric_limits<DCELIndex>::max()), _prev(std::numeric_limits<DCELIndex>::max()),
+    _face(std::numeric_limits<DCELIndex>::max()) {
 }
 
-inline HalfEdge::HalfEdge(size_t origin, size_t twin, size_t next, size_t prev) :
-                          _origin(origin), _twin(twin), _next(next), _prev(prev) {
+inline HalfEdge::HalfEdge(size_t origin, size_t next, size_t prev) :
+                          _origin(toDCELIndex(origin)), _next(toDCELIndex(next)), _prev(toDCELIndex(prev)),
+                          _face(std::numeric_limits<DCELIndex>::max()) {
+}
+#else
+inline HalfEdge::HalfEdge() : _origin(std::numeric_limits<DCELIndex>::max()), _twin(std::numeric_limits<DCELIndex>::max()),
+    _next(std::numeric_limits<DCELIndex>::max()), _prev(std::numeric_limits<DCELIndex>::max()),
+    _face(std::numeric_limits<DCELIndex>::max()) {
 }
 
-inline size_t HalfEdge::getOriginID() const {
-    return _origin;
+inline HalfEdge::HalfEdge(size_t origin, size_t twin, size_t next, size_t prev) :
+                          _origin(origin), _twin(twin), _next(next), _prev(prev), _face(std::numeric_limits<DCELIndex>::max()) {
 }
 
 inline size_t HalfEdge::getTwinID() const {
     return _twin;
 }
 
+inline void HalfEdge::setTwin(size_t twin) {
+    _twin = twin;
+}
+#endif
+
+inline size_t HalfEdge::getOriginID() const {
+    return fromDCELIndex(_origin);
+}
+
 inline size_t HalfEdge::getNextID() const {
-    return _next;
+    return fromDCELIndex(_next);
 }
 
 inline size_t HalfEdge::getPrevID() const {
-    return _prev;
+    return fromDCELIndex(_prev);
 }
 
-inline void HalfEdge::setOrigin(size_t origin) {
-    _origin = origin;
+inline size_t HalfEdge::getFaceID() const {
+    return fromDCELIndex(_face);
 }
 
-inline void HalfEdge::setTwin(size_t twin) {
-    _twin = twin;
+inline void HalfEdge::setOrigin(size_t origin) {
+    _origin = toDCELIndex(origin);
 }
 
 inline void HalfEdge::setNext(size_t next) {
-    _next = next;
+    _next = toDCELIndex(next);
 }
 
 inline void HalfEdge::setPrev(size_t prev) {
-    _prev = prev;
+    _prev = toDCELIndex(prev);
+}
+
+inline void HalfEdge::setFace(size_t face) {
+    _face = toDCELIndex(face);
 }
 
 }
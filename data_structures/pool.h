@@ -0,0 +1,63 @@
+#ifndef POOL_H
+#define POOL_H
+
+#include <vector>
+#include <stddef.h> //for size_t
+
+namespace Voronoi {
+
+    /**
+     * @class Pool
+     * @brief The Pool class, a typed free-list allocator.
+     * Objects are stored in chunks of growing size that are never given back to the system until release()
+     * or the destruction of the pool: destroyed objects go in a free list and are reused by the next create().
+     * reset() makes all the memory available again in O(1), without calling the destructors of the live objects,
+     * hence it must be used only with types whose destructor does not need to run (e.g. nodes and events).
+     */
+    template <class T>
+    class Pool {
+        public:
+            Pool();
+            Pool(const Pool&) = delete;
+            Pool(Pool&& other);
+            Pool& operator=(const Pool&) = delete;
+            Pool& operator=(Pool&& other);
+            ~Pool();
+
+            template <class... Args>
+            T* create(Args&&... args);
+            void destroy(T* object);
+
+            void reset();
+            void release();
+            void reserve(size_t capacity);
+            void swap(Pool& other);
+
+            size_t size() const;
+            size_t capacity() const;
+
+        private:
+            union Slot {
+                Slot* next;
+                alignas(T) unsigned char object[sizeof(T)];
+            };
+
+            //chunks of slots, chunkSizes[i] is the number of slots of chunks[i]
+            std::vector<Slot*> chunks;
+            std::vector<size_t> chunkSizes;
+            //chunk where the next slot is taken if the free list is empty, and slots already taken from it
+            size_t currentChunk;
+            size_t used;
+            Slot* freeList;
+            size_t nObjects;
+            size_t nSlots;
+
+            Slot* allocateSlot();
+            void addChunk(size_t nSlots);
+    };
+
+}
+
+#include "pool.tpp"
+
+#endif // POOL_H
@@ -0,0 +1,157 @@
+#include "pool.h"
+
+#include <new>
+#include <algorithm>
+#include <utility>
+#include <assert.h>
+
+#define POOL_FIRST_CHUNK_SIZE 256
+#define POOL_MAX_CHUNK_SIZE 65536
+
+namespace Voronoi {
+
+template <class T>
+inline Pool<T>::Pool() : currentChunk(0), used(0), freeList(nullptr), nObjects(0), nSlots(0) {
+}
+
+template <class T>
+inline Pool<T>::Pool(Pool&& other) : Pool() {
+    swap(other);
+}
+
+template <class T>
+inline Pool<T>& Pool<T>::operator=(Pool&& other) {
+    release();
+    swap(other);
+    return *this;
+}
+
+template <class T>
+inline Pool<T>::~Pool() {
+    release();
+}
+
+/**
+ * @brief Pool::create constructs an object in a free slot of the pool
+ * @param args: arguments forwarded to the constructor of T
+ * @return the pointer to the new object
+ */
+template <class T>
+template <class... Args>
+inline T* Pool<T>::create(Args&&... args) {
+    Slot* slot = allocateSlot();
+    nObjects++;
+    return new (slot->object) T(std::forward<Args>(args)...);
+}
+
+/**
+ * @brief Pool::destroy destructs an object created by this pool and puts its slot in the free list
+ * @param object
+ */
+template <class T>
+inline void Pool<T>::destroy(T* object) {
+    assert(nObjects > 0);
+    object->~T();
+    Slot* slot = reinterpret_cast<Slot*>(object);
+    slot->next = freeList;
+    freeList = slot;
+    nObjects--;
+}
+
+/**
+ * @brief Pool::reset all the slots become free, the memory is kept for the next objects.
+ * The destructors of the live objects are not called
+ */
+template <class T>
+inline void Pool<T>::reset() {
+    currentChunk = 0;
+    used = 0;
+    freeList = nullptr;
+    nObjects = 0;
+}
+
+/**
+ * @brief Pool::release gives back all the memory of the pool.
+ * The destructors of the live objects are not called
+ */
+template <class T>
+inline void Pool<T>::release() {
+    for(Slot* chunk : chunks)
+        delete[] chunk;
+    chunks.clear();
+    chunkSizes.clear();
+    nSlots = 0;
+    reset();
+}
+
+/**
+ * @brief Pool::reserve makes sure that at least capacity slots are allocated
+ * @param capacity
+ */
+template <class T>
+inline void Pool<T>::reserve(size_t capacity) {
+    if(capacity > nSlots)
+        addChunk(capacity - nSlots);
+}
+
+template <class T>
+inline void Pool<T>::swap(Pool& other) {
+    using std::swap;
+    swap(chunks, other.chunks);
+    swap(chunkSizes, other.chunkSizes);
+    swap(currentChunk, other.currentChunk);
+    swap(used, other.used);
+    swap(freeList, other.freeList);
+    swap(nObjects, other.nObjects);
+    swap(nSlots, other.nSlots);
+}
+
+/**
+ * @brief Pool::size
+ * @return number of live objects
+ */
+template <class T>
+inline size_t Pool<T>::size() const {
+    return nObjects;
+}
+
+/**
+ * @brief Pool::capacity
+ * @return number of allocated slots
+ */
+template <class T>
+inline size_t Pool<T>::capacity() const {
+    return nSlots;
+}
+
+/**
+ * @brief Pool::allocateSlot takes a slot from the free list, or the first never used slot of the chunks,
+ * allocating a new chunk if all of them are full
+ * @return the slot
+ */
+template <class T>
+inline typename Pool<T>::Slot* Pool<T>::allocateSlot() {
+    if(freeList) {
+        Slot* slot = freeList;
+        freeList = slot->next;
+        return slot;
+    }
+    while(currentChunk < chunks.size() && used == chunkSizes[currentChunk]) {
+        currentChunk++;
+        used = 0;
+    }
+    if(currentChunk == chunks.size()) {
+        size_t size = chunks.empty() ? POOL_FIRST_CHUNK_SIZE : std::min(chunkSizes.back()*2, (size_t)POOL_MAX_CHUNK_SIZE);
+        addChunk(size);
+    }
+    return &chunks[currentChunk][used++];
+}
+
+template <class T>
+inline void Pool<T>::addChunk(size_t size) {
+    chunks.push_back(new Slot[size]);
+    chunkSizes.push_back(size);
+    nSlots += size;
+}
+
+}
@@ -0,0 +1,94 @@
+#ifndef SITESPAN_H
+#define SITESPAN_H
+
+#include <cg3/geometry/2d/point2d.h>
+#include <vector>
+
+namespace Voronoi {
+
+    /**
+     * @class SiteSpan
+     * @brief The SiteSpan class, a read-only view of the coordinates of n sites stored by the caller, without copies.
+     * The x and the y of each site are read at a fixed stride from two base addresses, so the same view describes
+     * a std::vector<cg3::Point2Dd>, an interleaved array x0 y0 x1 y1 ... of 2n doubles, or two columns of n doubles.
+     * The sites are referred to by their index in the view, which is also the index of their face in the DCEL.
+     * The memory must stay valid and unchanged while the view is used
+     */
+    class SiteSpan {
+        public:
+            SiteSpan();
+            SiteSpan(const std::vector<cg3::Point2Dd>& points);
+            SiteSpan(const double* xy, size_t size);
+            SiteSpan(const double* x, const double* y, size_t size);
+
+            size_t size() const;
+            bool empty() const;
+            double x(size_t i) const;
+            double y(size_t i) const;
+            cg3::Point2Dd operator[](size_t i) const;
+
+        private:
+            const char* xs;
+            const char* ys;
+            //distance in bytes between the coordinates of two consecutive sites
+            size_t stride;
+            size_t n;
+    };
+
+    inline SiteSpan::SiteSpan() : xs(nullptr), ys(nullptr), stride(0), n(0) {}
+
+    /**
+     * @brief SiteSpan::SiteSpan view of a vector of points, it isn't explicit so the engine can still be called with a vector
+     * @param points
+     */
+    inline SiteSpan::SiteSpan(const std::vector<cg3::Point2Dd>& points) :
+        xs(points.empty() ? nullptr : reinterpret_cast<const char*>(&points[0].x())),
+        ys(points.empty() ? nullptr : reinterpret_cast<const char*>(&points[0].y())),
+        stride(sizeof(cg3::Point2Dd)), n(points.size()) {}
+
+    /**
+     * @brief SiteSpan::SiteSpan view of interleaved coordinates
+     * @param xy: x0 y0 x1 y1 ..., 2*size doubles
+     * @param size: number of sites
+     */
+    inline SiteSpan::SiteSpan(const double* xy, size_t size) :
+        xs(reinterpret_cast<const char*>(xy)), ys(reinterpret_cast<const char*>(xy + 1)),
+        stride(2*sizeof(double)), n(size) {}
+
+    /**
+     * @brief SiteSpan::SiteSpan view of two columns of coordinates
+     * @param x: size x-coordinates
+     * @param y: size y-coordinates
+     * @param size: number of sites
+     */
+    inline SiteSpan::SiteSpan(const double* x, const double* y, size_t size) :
+        xs(reinterpret_cast<const char*>(x)), ys(reinterpret_cast<const char*>(y)),
+        stride(sizeof(double)), n(size) {}
+
+    inline size_t SiteSpan::size() const {
+        return n;
+    }
+
+    inline bool SiteSpan::empty() const {
+        return n == 0;
+    }
+
+    inline double SiteSpan::x(size_t i) const {
+        return *reinterpret_cast<const double*>(xs + i*stride);
+    }
+
+    inline double SiteSpan::y(size_t i) const {
+        return *reinterpret_cast<const double*>(ys + i*stride);
+    }
+
+    /**
+     * @brief SiteSpan::operator []
+     * @param i
+     * @return a copy of the site i
+     */
+    inline cg3::Point2Dd SiteSpan::operator[](size_t i) const {
+        return cg3::Point2Dd(x(i), y(i));
+    }
+}
+
+#endif // SITESPAN_H
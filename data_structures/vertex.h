@@ -2,11 +2,28 @@
 #define VERTEX_H
 
 #include <cg3/geometry/2d/point2d.h>
+#include "dcel_index.h"
+
+#if defined(VORONOI_COMPACT_DCEL) || defined(VORONOI_FLOAT_COORDINATES)
+#define VORONOI_PLAIN_VERTEX
+#endif
 
 namespace Voronoi {
+
+#ifdef VORONOI_FLOAT_COORDINATES
+    typedef float VertexCoordinate;
+#else
+    typedef double VertexCoordinate;
+#endif
+
     /**
      * @class Vertex
-     * @brief The Vertex class models a DCEL Vertex
+     * @brief The Vertex class models a DCEL Vertex.
+     * With VORONOI_COMPACT_DCEL defined it stores the plain coordinates instead of a cg3::Point2Dd
+     * (which carries the vtable pointer of SerializableObject), and getCoordinates returns a copy.
+     * With VORONOI_FLOAT_COORDINATES defined the plain coordinates are floats: the diagram is computed in double
+     * and its vertexs are rounded when they are stored, as offsets from the origin of their DCEL
+     * (DCEL::getVertexCoordinates and DCEL::makeVertex convert them)
      */
     class Vertex {
         public:
@@ -14,13 +31,21 @@ namespace Voronoi {
             Vertex(const cg3::Point2Dd& coordinates);
             Vertex(const cg3::Point2Dd& coordinates, const size_t incidEdge);
 
+#ifdef VORONOI_PLAIN_VERTEX
+            cg3::Point2Dd getCoordinates() const;
+#else
             const cg3::Point2Dd& getCoordinates() const;
+#endif
             size_t getIncidEdgeID() const;
             void setIncidEdge(const size_t incidEdge);
             void setCoordinates(const cg3::Point2Dd& p);
     private:
+#ifdef VORONOI_PLAIN_VERTEX
+            VertexCoordinate _x, _y;
+#else
             cg3::Point2Dd _coordinates;
-            size_t _incidEdge;
+#endif
+            DCELIndex _incidEdge;
     };
 
 }
@@ -2,6 +2,28 @@
 
 namespace Voronoi {
 
+#ifdef VORONOI_PLAIN_VERTEX
+inline Vertex::Vertex() : _x(0), _y(0), _incidEdge() {
+}
+
+inline Vertex::Vertex(const cg3::Point2Dd& coordinates):
+    _x(static_cast<VertexCoordinate>(coordinates.x())), _y(static_cast<VertexCoordinate>(coordinates.y())), _incidEdge() {
+}
+
+inline Vertex::Vertex(const cg3::Point2Dd& coordinates, const size_t incidEdge) :
+    _x(static_cast<VertexCoordinate>(coordinates.x())), _y(static_cast<VertexCoordinate>(coordinates.y())),
+    _incidEdge(toDCELIndex(incidEdge)) {
+}
+
+inline cg3::Point2Dd Vertex::getCoordinates() const {
+    return cg3::Point2Dd(_x, _y);
+}
+
+inline void Vertex::setCoordinates(const cg3::Point2Dd &p) {
+    _x = static_cast<VertexCoordinate>(p.x());
+    _y = static_cast<VertexCoordinate>(p.y());
+}
+#else
 inline Vertex::Vertex() : _coordinates(), _incidEdge() {
 }
 
@@ -16,16 +38,17 @@ inline const cg3::Point2Dd& Vertex::getCoordinates() const {
     return _coordinates;
 }
 
-inline size_t Vertex::getIncidEdgeID() const {
-    return _incidEdge;
+inline void Vertex::setCoordinates(const cg3::Point2Dd &p) {
+    _coordinates = p;
 }
+#endif
 
-inline void Vertex::setIncidEdge(size_t incidEdge) {
-    _incidEdge = incidEdge;
+inline size_t Vertex::getIncidEdgeID() const {
+    return fromDCELIndex(_incidEdge);
 }
 
-inline void Vertex::setCoordinates(const cg3::Point2Dd &p) {
-    _coordinates = p;
+inline void Vertex::setIncidEdge(size_t incidEdge) {
+    _incidEdge = toDCELIndex(incidEdge);
 }
 
 }
@@ -42,7 +42,8 @@ VoronoiManager::VoronoiManager(QWidget *parent) :
     mainWindow((cg3::viewer::MainWindow&)*parent),
     boundingBox(cg3::Point2Dd(-BOUNDINGBOX, -BOUNDINGBOX),
                 cg3::Point2Dd(BOUNDINGBOX, BOUNDINGBOX)),
-    voronoiDiagram()
+    voronoiDiagram(),
+    isDiagramUpToDate(false)
 {
     //***** NOTE: you probably need to initialize your objects in the constructor *****
 
@@ -111,7 +112,8 @@ VoronoiManager::~VoronoiManager() {
 
 /**
  * @brief Launch fortune algorithm for a vector of points.
- * Note that the vector could contain duplicates.
+ * Note that the vector could contain duplicates: they are collapsed before the sweep,
+ * siteCells gives the face of each point.
  * @param[in] points Vector of points
  */
 void VoronoiManager::computeVoronoiDiagram(const std::vector<cg3::Point2Dd>& inputPoints) {
@@ -120,7 +122,9 @@ void VoronoiManager::computeVoronoiDiagram(const std::vector<cg3::Point2Dd>& inp
     //Here you should call an algorithm (obviously defined in another file!) which
     //fills your output Voronoi Diagram data structure.
     /*****************************************/
-    Voronoi::fortuneAlgorithm(inputPoints, voronoiDiagram, boundingBox);
+    Voronoi::collapseDuplicateSites(inputPoints, uniqueSites, siteCells);
+    fortuneEngine.compute(Voronoi::SiteSpan(uniqueSites.data(), uniqueSites.size()/2), voronoiDiagram, boundingBox);
+    isDiagramUpToDate = true;
     /*****************************************/
 
     //You should delete this line after you implement the algorithm: it is
@@ -135,6 +139,8 @@ void VoronoiManager::clearVoronoiDiagram() {
     //Clear here your Voronoi diagram data structure.
     /*****************************************/
     voronoiDiagram.clear();
+    siteCells.clear();
+    isDiagramUpToDate = false;
     /*****************************************/
 }
 
@@ -327,15 +333,30 @@ void VoronoiManager::point2DClicked(const cg3::Point2Dd& p) { //Do not write cod
         //Add the clicked point to the vector of points
         this->points.push_back(p);
 
-        //Clear data
-        clearVoronoiDiagram();
-
-        //Delete from the canvas the Voronoi diagram
-        eraseDrawnVoronoiDiagram();
-
-        //Launch the algorithm on the current vector of points and measure
-        //its efficiency with a timer
-        launchAlgorithmAndMeasureTime();
+        //The diagram can be updated locally only if it was computed on the previous points
+        if (isDiagramUpToDate) {
+            //Rebuild only the cells around the new point
+            cg3::Timer t("Voronoi diagram site insertion");
+            size_t face = Voronoi::insertSite(p, voronoiDiagram, boundingBox);
+            t.stopAndPrint();
+            ui->timeLabel->setNum(t.delay());
+
+            //A point equal to a previous one gets a face without a cell, it is mapped to the cell of the previous one
+            if (voronoiDiagram.getFaces()[face].getIncidEdgeID() == std::numeric_limits<size_t>::max())
+                face = Voronoi::locateSite(voronoiDiagram, p);
+            siteCells.push_back(face);
+        }
+        else {
+            //Clear data
+            clearVoronoiDiagram();
+
+            //Delete from the canvas the Voronoi diagram
+            eraseDrawnVoronoiDiagram();
+
+            //Launch the algorithm on the current vector of points and measure
+            //its efficiency with a timer
+            launchAlgorithmAndMeasureTime();
+        }
 
         //Draw in the canvas the Voronoi diagram
         drawVoronoiDiagram();
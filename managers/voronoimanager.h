@@ -7,6 +7,9 @@
 
 #include <cg3/viewer/drawable_objects/2d/drawable_bounding_box2d.h>
 #include <../algorithms/voronoidiagram.h>
+#include <../algorithms/fortuneengine.h>
+#include <../algorithms/duplicates.h>
+#include <../algorithms/incremental.h>
 #include "../viewer/drawablevoronoidiagram.h"
 
 
@@ -43,6 +46,13 @@ private:
     //Declare your attributes here
     /*****************************************/
     Voronoi::DrawableVoronoiDiagram voronoiDiagram;
+    //Keeps the memory of the sweep between the runs of the algorithm
+    Voronoi::FortuneEngine fortuneEngine;
+    //The input points without duplicates, and the face of the cell of each input point
+    std::vector<double> uniqueSites;
+    std::vector<size_t> siteCells;
+    //True if voronoiDiagram is the diagram of points, so a new point can be inserted in it
+    bool isDiagramUpToDate;
     /*****************************************/
 
     /* ----- Private main methods ----- */
@@ -1,21 +1,35 @@
 #include "circle.h"
 
+#include "predicates.h"
+
 namespace Voronoi {
 
+    /**
+     * @brief findCircleCenter computes the center of the circle through a, b and c, relatively to a
+     * @return false if the points are collinear (decided exactly), so the circle does not exist
+     */
     bool findCircleCenter(const cg3::Point2Dd& a, const cg3::Point2Dd& b, const cg3::Point2Dd& c, cg3::Point2Dd& center) {
-        double m1 = (a.x() - b.x())/(b.y() - a.y()),
-                m2 = (a.x() - c.x())/(c.y() - a.y());
-
-        //if points are collinear
-        if(fabs(m1-m2) < 1.0e-6)
+        if(exactOrientation(a, b, c) == 0)
             return false;
 
-        double x = 0.5 * (a.x() + (b.x()*m1 - b.y() + c.y() - c.x()*m2)/(m1 - m2));
-        double y = 0.5 * (a.y() + b.y() + (2*x - a.x() - b.x())*m1);
-
-        center.set(x,y);
+        double bx = b.x() - a.x(), by = b.y() - a.y(), cx = c.x() - a.x(), cy = c.y() - a.y();
+        double d = 2*(bx*cy - by*cx), b2 = bx*bx + by*by, c2 = cx*cx + cy*cy;
+        if(d == 0)
+            return false;
+        center.set(a.x() + (cy*b2 - by*c2)/d, a.y() + (bx*c2 - cx*b2)/d);
 
         return true;
     }
 
+    /**
+     * @brief checkBreakpointsConvergence: check if the breakpoints of the arc of middle, between the arcs of left and right,
+     * move towards each other while the sweepline goes down. This happens only if left, middle and right are a clockwise
+     * triple, otherwise the arc of middle never disappears (collinear sites included). The orientation is exact
+     * @param left, middle, right: the sites of three consecutive arcs of the beachline
+     * @return true if the arc of middle can disappear in a circle event
+     */
+    bool checkBreakpointsConvergence(const cg3::Point2Dd& left, const cg3::Point2Dd& middle, const cg3::Point2Dd& right) {
+        return exactOrientation(left, middle, right) < 0;
+    }
+
 }
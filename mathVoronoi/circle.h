@@ -6,6 +6,7 @@
 namespace Voronoi {
 
     bool findCircleCenter(const cg3::Point2Dd& a, const cg3::Point2Dd& b, const cg3::Point2Dd& c, cg3::Point2Dd& center);
+    bool checkBreakpointsConvergence(const cg3::Point2Dd& left, const cg3::Point2Dd& middle, const cg3::Point2Dd& right);
 
 }
 
@@ -3,6 +3,8 @@
 
 #include <cg3/geometry/2d/point2d.h>
 #include <vector>
+#include <limits>
+#include <math.h>
 
 #define POINT_EPSILON 1.0e-6
 
@@ -17,6 +19,64 @@ namespace Voronoi {
      */
     std::vector<cg3::Point2Dd> findIntersectionPoint(const cg3::Point2Dd& p1, const cg3::Point2Dd& p2, const double& sweepline);
 
+    /**
+     * @brief The BreakpointFunction class gives the x-coordinate of the breakpoint between the arc of a left focus
+     * and the arc of a right focus as a function of the sweepline, without allocations.
+     * The parabolas intersect where a*x^2 - 2*(p - d*dx)*x + (q - d*ds - d^2*a) = 0 (d is the sweepline),
+     * the coefficients that depend only on the foci are computed once, and the last value is memoized
+     * because the same breakpoint is often evaluated more times with the same sweepline
+     */
+    class BreakpointFunction {
+        public:
+            BreakpointFunction(double leftX, double leftY, double rightX, double rightY);
+
+            double x(double sweepline) const;
+
+        private:
+            //Left focus, u = xr - xl, a = yr - yl and the distance between the foci
+            double xl, yl, yr, u, a, distance;
+
+            mutable double memoSweepline;
+            mutable double memoX;
+    };
+
+    inline BreakpointFunction::BreakpointFunction(double leftX, double leftY, double rightX, double rightY) :
+        xl(leftX), yl(leftY), yr(rightY), u(rightX - leftX), a(rightY - leftY),
+        memoSweepline(std::numeric_limits<double>::quiet_NaN()), memoX(0) {
+        distance = sqrt(u*u + a*a);
+    }
+
+    /**
+     * @brief BreakpointFunction::x
+     * @param sweepline
+     * @return the x-coordinate of the breakpoint: the right intersection of the parabolas if the left focus
+     * is the lower one, the left intersection otherwise
+     *
+     * With hl, hr the heights of the foci over the sweepline and X = x - xl the breakpoint solves
+     * a*X^2 + 2*hl*u*X - hl*(u^2 + hr*a) = 0, whose discriminant is hl*hr*distance^2:
+     * the root is computed without cancellation and the results are computed relatively to the left focus.
+     */
+    inline double BreakpointFunction::x(double sweepline) const {
+        if(sweepline == memoSweepline)
+            return memoX;
+
+        double result;
+        if(a == 0) {
+            result = xl + u/2;
+        } else {
+            double hl = yl - sweepline, hr = yr - sweepline;
+            double h = hl*hr;
+            double root = h > 0 ? sqrt(h)*distance : 0;
+            double b = hl*u;
+            //(root - b)/a is the wanted intersection in both cases, the second form avoids cancellation
+            result = xl + (b > 0 ? hl*(u*u + hr*a)/(root + b) : (root - b)/a);
+        }
+
+        memoSweepline = sweepline;
+        memoX = result;
+        return result;
+    }
+
 }
 
 #endif // PARABOLA_H
@@ -0,0 +1,214 @@
+#include "predicates.h"
+
+#include <algorithm>
+#include <assert.h>
+#include <cmath>
+
+//Bound of the relative error of the floating point orientation, (3 + 16*eps)*eps with eps = 2^-53
+#define ORIENTATION_ERROR_BOUND 3.3306690738754716e-16
+//Bound of the relative error of the floating point in-circle, (10 + 96*eps)*eps
+#define IN_CIRCLE_ERROR_BOUND 1.1102230246251577e-15
+
+namespace Voronoi {
+
+    namespace internal {
+
+        /**
+         * An expansion is a sum of doubles, nonoverlapping and sorted by increasing magnitude (Shewchuk),
+         * which represents exactly the result of sums and products of doubles. Its sign is the sign of the last component.
+         * The zero components are removed, the zero expansion is a single 0.
+         * The expansions are arrays on the stack with their length, as in Shewchuk's predicates: a difference of two doubles
+         * has at most 2 components, the sum of two expansions of m and n components m + n, their product 2mn.
+         * The factors of the products below have at most 16 components, so their products at most 512
+         */
+        const size_t EXPANSION_FACTOR_CAPACITY = 16;
+        const size_t EXPANSION_PRODUCT_CAPACITY = 2*EXPANSION_FACTOR_CAPACITY*EXPANSION_FACTOR_CAPACITY;
+
+        /**
+         * @brief twoSum x + y = a + b exactly, with x the rounded sum
+         */
+        inline void twoSum(double a, double b, double& x, double& y) {
+            x = a + b;
+            double bVirtual = x - a, aVirtual = x - bVirtual;
+            y = (a - aVirtual) + (b - bVirtual);
+        }
+
+        /**
+         * @brief twoProduct x + y = a*b exactly, with x the rounded product
+         */
+        inline void twoProduct(double a, double b, double& x, double& y) {
+            x = a*b;
+            y = std::fma(a, b, -x);
+        }
+
+        /**
+         * @brief expansionDifference the expansion of a - b
+         * @return the number of components written in result, at most 2
+         */
+        size_t expansionDifference(double a, double b, double* result) {
+            double x, y;
+            twoSum(a, -b, x, y);
+            size_t n = 0;
+            if(y != 0)
+                result[n++] = y;
+            result[n++] = x;
+            return n;
+        }
+
+        /**
+         * @brief expansionSum the expansion of e + sign*f: the components of both, merged by magnitude, are accumulated with twoSum
+         * @return the number of components written in result, at most eLength + fLength
+         */
+        size_t expansionSum(const double* e, size_t eLength, const double* f, size_t fLength, double sign, double* result) {
+            size_t i = 0, j = 0, n = 0;
+            double q = 0;
+            bool first = true;
+            while(i < eLength || j < fLength) {
+                double next;
+                if(j == fLength || (i < eLength && std::fabs(e[i]) < std::fabs(f[j])))
+                    next = e[i++];
+                else
+                    next = sign*f[j++];
+                if(first) {
+                    q = next;
+                    first = false;
+                    continue;
+                }
+                double x, y;
+                twoSum(q, next, x, y);
+                if(y != 0)
+                    result[n++] = y;
+                q = x;
+            }
+            if(q != 0 || n == 0)
+                result[n++] = q;
+            return n;
+        }
+
+        /**
+         * @brief scaleExpansion the expansion of e*b
+         * @return the number of components written in result, at most 2*eLength
+         */
+        size_t scaleExpansion(const double* e, size_t eLength, double b, double* result) {
+            size_t n = 0;
+            double q, low;
+            twoProduct(e[0], b, q, low);
+            if(low != 0)
+                result[n++] = low;
+            for(size_t i = 1; i < eLength; i++) {
+                double high, partial, x, y;
+                twoProduct(e[i], b, high, low);
+                twoSum(q, low, partial, y);
+                if(y != 0)
+                    result[n++] = y;
+                twoSum(high, partial, q, x);
+                if(x != 0)
+                    result[n++] = x;
+            }
+            if(q != 0 || n == 0)
+                result[n++] = q;
+            return n;
+        }
+
+        /**
+         * @brief expansionProduct the expansion of e*f, as the sum of e scaled by each component of f
+         * @param e, f: at most EXPANSION_FACTOR_CAPACITY components each
+         * @return the number of components written in result, at most EXPANSION_PRODUCT_CAPACITY
+         */
+        size_t expansionProduct(const double* e, size_t eLength, const double* f, size_t fLength, double* result) {
+            assert(eLength <= EXPANSION_FACTOR_CAPACITY && fLength <= EXPANSION_FACTOR_CAPACITY);
+            double scaled[2*EXPANSION_FACTOR_CAPACITY], partial[EXPANSION_PRODUCT_CAPACITY];
+            size_t n = 1;
+            result[0] = 0;
+            for(size_t j = 0; j < fLength; j++) {
+                size_t nScaled = scaleExpansion(e, eLength, f[j], scaled);
+                n = expansionSum(result, n, scaled, nScaled, 1, partial);
+                std::copy(partial, partial + n, result);
+            }
+            return n;
+        }
+
+        inline int expansionSign(const double* e, size_t eLength) {
+            return (e[eLength-1] > 0) - (e[eLength-1] < 0);
+        }
+
+        int exactOrientationSign(const cg3::Point2Dd& a, const cg3::Point2Dd& b, const cg3::Point2Dd& c) {
+            double acx[2], acy[2], bcx[2], bcy[2], left[8], right[8], det[16];
+            size_t nAcx = expansionDifference(a.x(), c.x(), acx);
+            size_t nAcy = expansionDifference(a.y(), c.y(), acy);
+            size_t nBcx = expansionDifference(b.x(), c.x(), bcx);
+            size_t nBcy = expansionDifference(b.y(), c.y(), bcy);
+            size_t nLeft = expansionProduct(acx, nAcx, bcy, nBcy, left);
+            size_t nRight = expansionProduct(acy, nAcy, bcx, nBcx, right);
+            return expansionSign(det, expansionSum(left, nLeft, right, nRight, -1, det));
+        }
+
+        int exactInCircleSign(const cg3::Point2Dd& a, const cg3::Point2Dd& b, const cg3::Point2Dd& c, const cg3::Point2Dd& d) {
+            double adx[2], ady[2], bdx[2], bdy[2], cdx[2], cdy[2];
+            size_t nAdx = expansionDifference(a.x(), d.x(), adx);
+            size_t nAdy = expansionDifference(a.y(), d.y(), ady);
+            size_t nBdx = expansionDifference(b.x(), d.x(), bdx);
+            size_t nBdy = expansionDifference(b.y(), d.y(), bdy);
+            size_t nCdx = expansionDifference(c.x(), d.x(), cdx);
+            size_t nCdy = expansionDifference(c.y(), d.y(), cdy);
+
+            //lift of p times the orientation of q and r, relatively to d: 16 components times 16 components
+            double square1[8], square2[8], lift[16], cross1[8], cross2[8], cross[16];
+            auto liftedTerm = [&](const double* px, size_t nPx, const double* py, size_t nPy, const double* qx, size_t nQx,
+                                  const double* qy, size_t nQy, const double* rx, size_t nRx, const double* ry, size_t nRy,
+                                  double* result) {
+                size_t nSquare1 = expansionProduct(px, nPx, px, nPx, square1);
+                size_t nSquare2 = expansionProduct(py, nPy, py, nPy, square2);
+                size_t nLift = expansionSum(square1, nSquare1, square2, nSquare2, 1, lift);
+                size_t nCross1 = expansionProduct(qx, nQx, ry, nRy, cross1);
+                size_t nCross2 = expansionProduct(rx, nRx, qy, nQy, cross2);
+                size_t nCross = expansionSum(cross1, nCross1, cross2, nCross2, -1, cross);
+                return expansionProduct(lift, nLift, cross, nCross, result);
+            };
+
+            double term[EXPANSION_PRODUCT_CAPACITY], partial[2*EXPANSION_PRODUCT_CAPACITY], det[3*EXPANSION_PRODUCT_CAPACITY];
+            size_t nDet = liftedTerm(adx, nAdx, ady, nAdy, bdx, nBdx, bdy, nBdy, cdx, nCdx, cdy, nCdy, det);
+            size_t nTerm = liftedTerm(bdx, nBdx, bdy, nBdy, cdx, nCdx, cdy, nCdy, adx, nAdx, ady, nAdy, term);
+            size_t nPartial = expansionSum(det, nDet, term, nTerm, 1, partial);
+            nTerm = liftedTerm(cdx, nCdx, cdy, nCdy, adx, nAdx, ady, nAdy, bdx, nBdx, bdy, nBdy, term);
+            nDet = expansionSum(partial, nPartial, term, nTerm, 1, det);
+            return expansionSign(det, nDet);
+        }
+
+    }
+
+    /**
+     * @brief exactOrientation the sign of the orientation of abc: positive if counterclockwise, negative if clockwise,
+     * zero if collinear. The floating point determinant is used when it is larger than its error bound,
+     * otherwise the determinant is evaluated exactly on expansions
+     */
+    int exactOrientation(const cg3::Point2Dd& a, const cg3::Point2Dd& b, const cg3::Point2Dd& c) {
+        double left = (a.x() - c.x())*(b.y() - c.y()), right = (a.y() - c.y())*(b.x() - c.x());
+        double det = left - right;
+        double bound = ORIENTATION_ERROR_BOUND*(std::fabs(left) + std::fabs(right));
+        if(det > bound || -det > bound)
+            return (det > 0) - (det < 0);
+        return internal::exactOrientationSign(a, b, c);
+    }
+
+    /**
+     * @brief exactInCircle the sign of the in-circle determinant: positive if d is inside the circle
+     * through the counterclockwise triangle abc, zero if the four points are cocircular.
+     * The floating point determinant is used when it is larger than its error bound, otherwise it is evaluated exactly
+     */
+    int exactInCircle(const cg3::Point2Dd& a, const cg3::Point2Dd& b, const cg3::Point2Dd& c, const cg3::Point2Dd& d) {
+        double adx = a.x() - d.x(), ady = a.y() - d.y();
+        double bdx = b.x() - d.x(), bdy = b.y() - d.y();
+        double cdx = c.x() - d.x(), cdy = c.y() - d.y();
+        double bdxcdy = bdx*cdy, cdxbdy = cdx*bdy, cdxady = cdx*ady, adxcdy = adx*cdy, adxbdy = adx*bdy, bdxady = bdx*ady;
+        double alift = adx*adx + ady*ady, blift = bdx*bdx + bdy*bdy, clift = cdx*cdx + cdy*cdy;
+        double det = alift*(bdxcdy - cdxbdy) + blift*(cdxady - adxcdy) + clift*(adxbdy - bdxady);
+        double permanent = (std::fabs(bdxcdy) + std::fabs(cdxbdy))*alift + (std::fabs(cdxady) + std::fabs(adxcdy))*blift +
+                           (std::fabs(adxbdy) + std::fabs(bdxady))*clift;
+        double bound = IN_CIRCLE_ERROR_BOUND*permanent;
+        if(det > bound || -det > bound)
+            return (det > 0) - (det < 0);
+        return internal::exactInCircleSign(a, b, c, d);
+    }
+
+}
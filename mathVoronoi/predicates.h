@@ -0,0 +1,13 @@
+#ifndef PREDICATES_H
+#define PREDICATES_H
+
+#include <cg3/geometry/2d/point2d.h>
+
+namespace Voronoi {
+
+    int exactOrientation(const cg3::Point2Dd& a, const cg3::Point2Dd& b, const cg3::Point2Dd& c);
+    int exactInCircle(const cg3::Point2Dd& a, const cg3::Point2Dd& b, const cg3::Point2Dd& c, const cg3::Point2Dd& d);
+
+}
+
+#endif // PREDICATES_H
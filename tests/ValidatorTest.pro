@@ -0,0 +1,28 @@
+# Checks the diagrams of the engines on degenerate sites (collinear, cocircular, on the corners of the box, duplicates)
+# with validateDiagram: equidistant vertexs, consistent next/prev/twin, cells covering the box. Built without Qt
+# like VoronoiEngine.pro; validator_test prints the failed cases and returns their number.
+
+TEMPLATE = app
+TARGET = validator_test
+
+CONFIG -= qt
+CONFIG += c++11 console
+
+win32 {
+    DEFINES += _USE_MATH_DEFINES
+}
+
+unix:!macx{
+    QMAKE_CXXFLAGS += -fopenmp
+    QMAKE_LFLAGS += -fopenmp
+}
+
+INCLUDEPATH += $$PWD/.. $$PWD/../cg3lib/cg3/core/
+
+include (../voronoi_engine.pri)
+
+SOURCES += \
+    $$PWD/validator_test.cpp
+
+HEADERS += \
+    $$PWD/validator.h
@@ -0,0 +1,114 @@
+#ifndef VALIDATOR_H
+#define VALIDATOR_H
+
+#include <data_structures/dcel.h>
+#include <cg3/geometry/2d/bounding_box2d.h>
+
+#include <cmath>
+#include <vector>
+
+/**
+ * @brief The DiagramCheck struct, the defects found by validateDiagram in a clipped diagram.
+ * badHalfEdges: halfEdges whose next, prev, twin, origin or face don't agree with their neighbours;
+ * badFaces: faces whose cycle doesn't close, leaves the face, or doesn't contain the site;
+ * badVertexs: vertexs not equidistant from the sites of the two faces of their halfEdge;
+ * zeroLengthHalfEdges: halfEdges with the same coordinates at both ends, outside the corners of the box;
+ * emptyFaces: faces without a cell (e.g. duplicate sites), allowed;
+ * liveHalfEdges, liveVertexs: halfEdges with an origin and vertexs origin of one of them, the ones of the diagram
+ * (the DCEL can keep the slots of the ones removed by the clipping);
+ * areaError: difference between the sum of the areas of the cells and the area of the box, relative to the latter
+ */
+struct DiagramCheck {
+    size_t badHalfEdges, badFaces, badVertexs, zeroLengthHalfEdges, emptyFaces, liveHalfEdges, liveVertexs;
+    double areaError;
+
+    DiagramCheck() : badHalfEdges(0), badFaces(0), badVertexs(0), zeroLengthHalfEdges(0), emptyFaces(0), liveHalfEdges(0),
+        liveVertexs(0), areaError(0) {}
+
+    bool valid(double areaTolerance = 1e-9) const {
+        return badHalfEdges == 0 && badFaces == 0 && badVertexs == 0 && areaError <= areaTolerance;
+    }
+};
+
+/**
+ * @brief validateDiagram checks the topology and the geometry of a diagram clipped to boundingBox
+ * @param tolerance: the largest distance error allowed, relative to the diagonal of the box
+ */
+inline DiagramCheck validateDiagram(const Voronoi::DCEL& dcel, const cg3::BoundingBox2D& boundingBox, double tolerance = 1e-9) {
+    const std::vector<Voronoi::HalfEdge>& edges = dcel.getHalfEdges();
+    const std::vector<Voronoi::Vertex>& vertexs = dcel.getVertexs();
+    const std::vector<Voronoi::Face>& faces = dcel.getFaces();
+    const size_t null = std::numeric_limits<size_t>::max();
+    const double diagonal = boundingBox.min().dist(boundingBox.max()), epsilon = tolerance*diagonal;
+    DiagramCheck check;
+    std::vector<bool> usedVertexs(vertexs.size(), false);
+
+    //Topology of the halfEdges still in the diagram (the ones with an origin)
+    auto isLive = [&](size_t e) {
+        return e < edges.size() && edges[e].getOriginID() != null && edges[e].getOriginID() < vertexs.size();
+    };
+    for(size_t e = 0; e < edges.size(); e++) {
+        if(edges[e].getOriginID() == null)
+            continue;
+        check.liveHalfEdges++;
+        if(edges[e].getOriginID() < vertexs.size() && !usedVertexs[edges[e].getOriginID()]) {
+            usedVertexs[edges[e].getOriginID()] = true;
+            check.liveVertexs++;
+        }
+        size_t next = edges[e].getNextID(), prev = edges[e].getPrevID(), twin = dcel.getTwinID(e);
+        if(!isLive(e) || !isLive(next) || !isLive(prev) || !isLive(twin) || dcel.getTwinID(twin) != e ||
+                edges[next].getPrevID() != e || edges[prev].getNextID() != e || edges[next].getFaceID() != edges[e].getFaceID() ||
+                edges[next].getOriginID() != edges[twin].getOriginID()) {
+            check.badHalfEdges++;
+            continue;
+        }
+        const cg3::Point2Dd a = dcel.getVertexCoordinates(edges[e].getOriginID()), b = dcel.getVertexCoordinates(edges[twin].getOriginID());
+        bool corner = (a.x() == boundingBox.min().x() || a.x() == boundingBox.max().x()) &&
+                      (a.y() == boundingBox.min().y() || a.y() == boundingBox.max().y());
+        if(a == b && !corner)
+            check.zeroLengthHalfEdges++;
+
+        //The origin lies on the bisector of the sites on the two sides
+        size_t face = edges[e].getFaceID(), twinFace = edges[twin].getFaceID();
+        if(face != null && twinFace != null && face < faces.size() && twinFace < faces.size() &&
+                std::abs(a.dist(faces[face].getSite()) - a.dist(faces[twinFace].getSite())) > epsilon)
+            check.badVertexs++;
+    }
+
+    //Cycles of the faces: closed, on the same face, counterclockwise around their site
+    double area = 0;
+    for(size_t f = 0; f < faces.size(); f++) {
+        size_t start = faces[f].getIncidEdgeID();
+        if(start == null) {
+            check.emptyFaces++;
+            continue;
+        }
+        if(!isLive(start)) {
+            check.badFaces++;
+            continue;
+        }
+        const cg3::Point2Dd site = faces[f].getSite();
+        double cellArea = 0;
+        bool closed = false, inside = true;
+        size_t e = start, steps = 0;
+        do {
+            if(!isLive(e) || edges[e].getFaceID() != f || !isLive(dcel.getTwinID(e)))
+                break;
+            const cg3::Point2Dd a = dcel.getVertexCoordinates(edges[e].getOriginID());
+            const cg3::Point2Dd b = dcel.getVertexCoordinates(edges[dcel.getTwinID(e)].getOriginID());
+            cellArea += (a.x() - site.x())*(b.y() - site.y()) - (b.x() - site.x())*(a.y() - site.y());
+            if((b.x() - a.x())*(site.y() - a.y()) - (b.y() - a.y())*(site.x() - a.x()) < -epsilon*diagonal)
+                inside = false;
+            e = edges[e].getNextID();
+            closed = e == start;
+        } while(!closed && ++steps < edges.size());
+        if(!closed || !inside || cellArea < -epsilon*epsilon)
+            check.badFaces++;
+        area += cellArea/2;
+    }
+    double boxArea = (boundingBox.max().x() - boundingBox.min().x())*(boundingBox.max().y() - boundingBox.min().y());
+    check.areaError = std::abs(area - boxArea)/boxArea;
+    return check;
+}
+
+#endif // VALIDATOR_H
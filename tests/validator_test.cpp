@@ -0,0 +1,333 @@
+#include <algorithms/voronoidiagram.h>
+#include <algorithms/fortuneengine.h>
+#include <algorithms/parallelfortune.h>
+#include <algorithms/kinetic.h>
+#include <algorithms/incremental.h>
+#include <algorithms/slidingwindow.h>
+#include "validator.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <string>
+
+//Largest distance error of the vertexs relative to the diagonal of the box, and area error relative to the box:
+//float coordinates are rounded to 2^-24 of the half side of the box
+#ifdef VORONOI_FLOAT_COORDINATES
+#define VALIDATOR_TOLERANCE 1e-6
+#else
+#define VALIDATOR_TOLERANCE 1e-9
+#endif
+
+//Heap allocations, counted to check that a FortuneEngine reuses its memory
+std::atomic<size_t> allocations(0);
+
+void* operator new(size_t size) {
+    allocations++;
+    void* p = std::malloc(size > 0 ? size : 1);
+    if(p == nullptr)
+        throw std::bad_alloc();
+    return p;
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    allocations++;
+    return std::malloc(size > 0 ? size : 1);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+    int failures = 0;
+
+    /**
+     * @brief expectValid prints the defects of the diagram, if any, and counts the failure.
+     * Zero length halfEdges are allowed only for degenerate sites (four or more on a circle)
+     */
+    void expectValid(const std::string& name, const Voronoi::DCEL& dcel, const cg3::BoundingBox2D& boundingBox, bool degenerate) {
+        DiagramCheck check = validateDiagram(dcel, boundingBox, VALIDATOR_TOLERANCE);
+        if(check.valid(VALIDATOR_TOLERANCE) && (degenerate || check.zeroLengthHalfEdges == 0))
+            return;
+        std::printf("FAILED %s: %zu halfEdges, %zu faces, %zu vertexs, %zu zero length, area error %g\n", name.c_str(),
+                    check.badHalfEdges, check.badFaces, check.badVertexs, check.zeroLengthHalfEdges, check.areaError);
+        failures++;
+    }
+
+    /**
+     * @brief expectValidEngines checks the diagram of the sites computed by each engine of computeVoronoiDiagram
+     */
+    void expectValidEngines(const std::string& name, const std::vector<cg3::Point2Dd>& points, const cg3::BoundingBox2D& boundingBox,
+                            bool degenerate = true) {
+        const Voronoi::VoronoiEngine engines[4] = {Voronoi::VoronoiEngine::FORTUNE, Voronoi::VoronoiEngine::DELAUNAY,
+                                                   Voronoi::VoronoiEngine::EXACT, Voronoi::VoronoiEngine::HALF_PLANE};
+        const char* engineNames[4] = {"fortune", "delaunay", "exact", "half-plane"};
+        for(int i = 0; i < 4; i++) {
+            Voronoi::DCEL dcel;
+            Voronoi::computeVoronoiDiagram(points, dcel, boundingBox, engines[i]);
+            expectValid(name + " (" + engineNames[i] + ")", dcel, boundingBox, degenerate);
+        }
+    }
+
+    /**
+     * @brief expectParallelMatches checks the diagram of the parallel sweep and compares the halfEdges and the vertexs
+     * left in it with the ones of the sequential sweep: the strips must not duplicate them on their seams
+     */
+    void expectParallelMatches(const std::string& name, const std::vector<cg3::Point2Dd>& points,
+                               const cg3::BoundingBox2D& boundingBox, bool degenerate) {
+        Voronoi::DCEL sequential;
+        Voronoi::fortuneAlgorithm(points, sequential, boundingBox);
+        DiagramCheck expected = validateDiagram(sequential, boundingBox, VALIDATOR_TOLERANCE);
+        for(int threads : {2, 4, 8}) {
+            Voronoi::DCEL parallel;
+            Voronoi::fortuneAlgorithmParallel(points, parallel, boundingBox, threads);
+            const std::string parallelName = name + " (parallel, " + std::to_string(threads) + " threads)";
+            expectValid(parallelName, parallel, boundingBox, degenerate);
+            DiagramCheck check = validateDiagram(parallel, boundingBox, VALIDATOR_TOLERANCE);
+            if(check.liveHalfEdges == expected.liveHalfEdges && check.liveVertexs == expected.liveVertexs)
+                continue;
+            std::printf("FAILED %s: %zu halfEdges and %zu vertexs, sequential %zu and %zu\n", parallelName.c_str(),
+                        check.liveHalfEdges, check.liveVertexs, expected.liveHalfEdges, expected.liveVertexs);
+            failures++;
+        }
+    }
+
+    /**
+     * @brief expectSitesHaveCells checks that each face of the list has a cell, or a face of its ring of coincident
+     * faces has one: a site removed from a group of equal sites must not take the cell of the others away
+     */
+    void expectSitesHaveCells(const std::string& name, const Voronoi::DCEL& dcel, const std::vector<size_t>& sites) {
+        const std::vector<Voronoi::Face>& faces = dcel.getFaces();
+        size_t nMissing = 0;
+        for(size_t face : sites) {
+            size_t f = face;
+            while(faces[f].getIncidEdgeID() == std::numeric_limits<size_t>::max() && dcel.getCoincidentFace(f) != face)
+                f = dcel.getCoincidentFace(f);
+            if(faces[f].getIncidEdgeID() == std::numeric_limits<size_t>::max() || faces[f].getSite() != faces[face].getSite())
+                nMissing++;
+        }
+        if(nMissing == 0)
+            return;
+        std::printf("FAILED %s: %zu sites without a cell\n", name.c_str(), nMissing);
+        failures++;
+    }
+
+    /**
+     * @brief expectValidIncremental inserts the sites one at a time, removes half of them and inserts them again,
+     * which must reuse their faces; it also removes half of the sites from the swept diagram
+     */
+    void expectValidIncremental(const std::string& name, const std::vector<cg3::Point2Dd>& points, const cg3::BoundingBox2D& boundingBox) {
+        Voronoi::DCEL dcel;
+        std::vector<size_t> faces, kept;
+        for(const cg3::Point2Dd& p : points)
+            faces.push_back(Voronoi::insertSite(p, dcel, boundingBox));
+        expectValid(name + " (insertSite)", dcel, boundingBox, true);
+        expectSitesHaveCells(name + " (insertSite)", dcel, faces);
+        for(size_t i = 0; i < faces.size(); i++) {
+            if(i % 2 == 0)
+                Voronoi::removeSite(faces[i], dcel, boundingBox);
+            else
+                kept.push_back(faces[i]);
+        }
+        expectValid(name + " (removeSite)", dcel, boundingBox, true);
+        expectSitesHaveCells(name + " (removeSite)", dcel, kept);
+        for(size_t i = 0; i < points.size(); i += 2)
+            kept.push_back(Voronoi::insertSite(points[i], dcel, boundingBox));
+        expectValid(name + " (insertSite after removeSite)", dcel, boundingBox, true);
+        expectSitesHaveCells(name + " (insertSite after removeSite)", dcel, kept);
+        if(dcel.getFaces().size() != points.size()) {
+            std::printf("FAILED %s: %zu faces for %zu sites\n", (name + " (insertSite after removeSite)").c_str(),
+                        dcel.getFaces().size(), points.size());
+            failures++;
+        }
+
+        Voronoi::DCEL swept;
+        Voronoi::fortuneAlgorithm(points, swept, boundingBox);
+        for(size_t face = 0; face < points.size(); face += 2)
+            Voronoi::removeSite(face, swept, boundingBox);
+        expectValid(name + " (removeSite after the sweep)", swept, boundingBox, true);
+        kept.resize(points.size()/2);
+        expectSitesHaveCells(name + " (removeSite after the sweep)", swept, kept);
+    }
+
+    /**
+     * @brief expectKineticMatches moves one site every step sites by sigma for a few frames with moveSites,
+     * and checks the diagram against the one computed again from the moved sites. Equal sites move apart
+     */
+    void expectKineticMatches(const std::string& name, std::vector<cg3::Point2Dd> points, const cg3::BoundingBox2D& boundingBox,
+                              double sigma, size_t step, std::mt19937_64& generator) {
+        std::normal_distribution<double> motion(0, sigma);
+        Voronoi::DCEL dcel;
+        Voronoi::fortuneAlgorithm(points, dcel, boundingBox);
+        for(int frame = 0; frame < 3; frame++) {
+            for(size_t i = 0; i < points.size(); i += step)
+                points[i] = cg3::Point2Dd(points[i].x() + motion(generator), points[i].y() + motion(generator));
+            Voronoi::moveSites(points, dcel, boundingBox);
+            const std::string frameName = name + ", frame " + std::to_string(frame);
+            expectValid(frameName, dcel, boundingBox, false);
+            std::vector<size_t> faces(points.size());
+            for(size_t face = 0; face < faces.size(); face++)
+                faces[face] = face;
+            expectSitesHaveCells(frameName, dcel, faces);
+            Voronoi::DCEL expected;
+            Voronoi::fortuneAlgorithm(points, expected, boundingBox);
+            DiagramCheck check = validateDiagram(dcel, boundingBox, VALIDATOR_TOLERANCE);
+            DiagramCheck expectedCheck = validateDiagram(expected, boundingBox, VALIDATOR_TOLERANCE);
+            if(check.liveHalfEdges == expectedCheck.liveHalfEdges && check.liveVertexs == expectedCheck.liveVertexs)
+                continue;
+            std::printf("FAILED %s: %zu halfEdges and %zu vertexs, recomputed %zu and %zu\n", frameName.c_str(),
+                        check.liveHalfEdges, check.liveVertexs, expectedCheck.liveHalfEdges, expectedCheck.liveVertexs);
+            failures++;
+        }
+    }
+
+    /**
+     * @brief expectWindowKeepsCopies streams sites with a copy of one of them arriving just before the first copy
+     * expires: the local update must leave the cell to the copy still in the window
+     */
+    void expectWindowKeepsCopies(const std::string& name, const std::vector<cg3::Point2Dd>& points,
+                                 const cg3::BoundingBox2D& boundingBox, const cg3::Point2Dd& repeated) {
+        const double window = 100, step = window/points.size();
+        Voronoi::SlidingWindowDiagram stream(boundingBox, window);
+        stream.push(repeated, 0);
+        for(size_t i = 0; i < points.size(); i++)
+            stream.push(points[i], i*step);
+        stream.tick(window - step);
+        stream.push(repeated, window - step/2);
+        stream.tick(window - step/2);
+        stream.tick(window + step/2);
+
+        const Voronoi::DCEL& dcel = stream.getDCEL();
+        std::vector<size_t> faces;
+        for(size_t face = 0; face < dcel.getFaces().size(); face++) {
+            if(!dcel.isFaceRemoved(face))
+                faces.push_back(face);
+        }
+        expectValid(name, dcel, boundingBox, false);
+        expectSitesHaveCells(name, dcel, faces);
+        if(stream.getStatistics().recomputations != 1 || faces.size() != stream.size()) {
+            std::printf("FAILED %s: %zu recomputations, %zu faces for %zu sites\n", name.c_str(),
+                        stream.getStatistics().recomputations, faces.size(), stream.size());
+            failures++;
+        }
+    }
+
+    /**
+     * @brief expectNoAllocations computes the diagram three times with the same FortuneEngine: the last run must not
+     * allocate, also when the exact predicates decide degenerate events
+     */
+    void expectNoAllocations(const std::string& name, const std::vector<cg3::Point2Dd>& points, const cg3::BoundingBox2D& boundingBox) {
+        Voronoi::FortuneEngine engine;
+        engine.compute(points, boundingBox);
+        engine.compute(points, boundingBox);
+        const size_t before = allocations;
+        engine.compute(points, boundingBox);
+        const size_t runAllocations = allocations - before;
+        if(runAllocations == 0)
+            return;
+        std::printf("FAILED %s (engine): %zu allocations after the first runs\n", name.c_str(), runAllocations);
+        failures++;
+    }
+
+}
+
+int main() {
+    const cg3::BoundingBox2D boundingBox(cg3::Point2Dd(-100, -100), cg3::Point2Dd(100, 100));
+
+    //Sites on the diagonal of the box: their bisectors leave it exactly through the corners
+    for(int n : {2, 3, 5, 20}) {
+        std::vector<cg3::Point2Dd> points;
+        for(int i = 0; i < n; i++)
+            points.push_back(cg3::Point2Dd(10.0*i - 5*(n-1), 10.0*i - 5*(n-1)));
+        expectValidEngines("diagonal " + std::to_string(n), points, boundingBox);
+        expectValidIncremental("diagonal " + std::to_string(n), points, boundingBox);
+    }
+
+    //Small integer sites: cocircular and collinear groups, centers on the sides and on the corners, duplicates
+    for(unsigned int seed = 0; seed < 200; seed++) {
+        std::mt19937_64 generator(seed);
+        std::uniform_int_distribution<int> coordinate(-5, 5);
+        std::vector<cg3::Point2Dd> points(8 + seed % 30);
+        for(cg3::Point2Dd& p : points)
+            p = cg3::Point2Dd(coordinate(generator)*10.0, coordinate(generator)*10.0);
+        expectValidEngines("integer sites, seed " + std::to_string(seed), points, boundingBox);
+        expectValidIncremental("integer sites, seed " + std::to_string(seed), points, boundingBox);
+    }
+
+    //Nearly degenerate sites: a grid moved by 1e-9 and many integer sites with duplicates, where the exact engine snaps
+    //sites off their common circles and the diagram gets edges much shorter than the rounding of its vertexs
+    std::mt19937_64 generator(1);
+    std::normal_distribution<double> jitter(0, 1e-9);
+    std::vector<cg3::Point2Dd> grid;
+    for(int i = 0; i < 10; i++) {
+        for(int j = 0; j < 10; j++)
+            grid.push_back(cg3::Point2Dd(15.0*i - 70 + jitter(generator), 15.0*j - 70 + jitter(generator)));
+    }
+    expectValidEngines("grid moved by 1e-9", grid, boundingBox);
+    std::uniform_int_distribution<int> coordinate(-50, 50);
+    std::vector<cg3::Point2Dd> integers(3000);
+    for(cg3::Point2Dd& p : integers)
+        p = cg3::Point2Dd(coordinate(generator)*1.9, coordinate(generator)*1.9);
+    expectValidEngines("3000 integer sites", integers, boundingBox);
+    expectValidIncremental("3000 integer sites", integers, boundingBox);
+
+    //Sites far from (0, 0): with VORONOI_FLOAT_COORDINATES the vertexs are stored relative to the center of the box
+    const double offset = 5e6;
+    const cg3::BoundingBox2D farBox(cg3::Point2Dd(offset - 1000, offset - 1000), cg3::Point2Dd(offset + 1000, offset + 1000));
+    std::uniform_real_distribution<double> farCoordinate(offset - 999, offset + 999);
+    std::vector<cg3::Point2Dd> farPoints(20000);
+    for(cg3::Point2Dd& p : farPoints)
+        p = cg3::Point2Dd(farCoordinate(generator), farCoordinate(generator));
+    expectValidEngines("20000 sites at 5e6", farPoints, farBox, false);
+
+    //Parallel sweep, above the sites that fall back to the sequential one: random sites and integer sites with duplicates
+    std::uniform_real_distribution<double> realCoordinate(-99, 99);
+    std::vector<cg3::Point2Dd> randomPoints(50000);
+    for(cg3::Point2Dd& p : randomPoints)
+        p = cg3::Point2Dd(realCoordinate(generator), realCoordinate(generator));
+    expectParallelMatches("50000 sites", randomPoints, boundingBox, false);
+    std::uniform_int_distribution<int> smallCoordinate(-99, 99);
+    std::vector<cg3::Point2Dd> integerPoints(30000);
+    for(cg3::Point2Dd& p : integerPoints)
+        p = cg3::Point2Dd(smallCoordinate(generator), smallCoordinate(generator));
+    expectParallelMatches("30000 integer sites", integerPoints, boundingBox, true);
+
+    //Sliding window: the first copy of a site expires while the second one stays
+    std::vector<cg3::Point2Dd> windowPoints(4000);
+    for(cg3::Point2Dd& p : windowPoints)
+        p = cg3::Point2Dd(realCoordinate(generator), realCoordinate(generator));
+    expectWindowKeepsCopies("sliding window with a repeated site", windowPoints, boundingBox, cg3::Point2Dd(10.5, 10.5));
+
+    //Reused engine: uniform sites, a grid (cocircular arcs decided by the exact predicates) and duplicates
+    std::vector<cg3::Point2Dd> engineGrid;
+    for(int i = 0; i < 100; i++) {
+        for(int j = 0; j < 100; j++)
+            engineGrid.push_back(cg3::Point2Dd(1.98*i - 98, 1.98*j - 98));
+    }
+    expectNoAllocations("10000 sites", std::vector<cg3::Point2Dd>(randomPoints.begin(), randomPoints.begin() + 10000), boundingBox);
+    expectNoAllocations("100x100 grid", engineGrid, boundingBox);
+    expectNoAllocations("30000 integer sites", integerPoints, boundingBox);
+
+    //Moving sites: all of them by a little, or a few of them past their old neighbours
+    const cg3::BoundingBox2D kineticBox(cg3::Point2Dd(-1000, -1000), cg3::Point2Dd(1000, 1000));
+    std::uniform_real_distribution<double> kineticCoordinate(-800, 800);
+    std::vector<cg3::Point2Dd> kineticPoints(20000);
+    for(cg3::Point2Dd& p : kineticPoints)
+        p = cg3::Point2Dd(kineticCoordinate(generator), kineticCoordinate(generator));
+    expectKineticMatches("moving sites by 0.01", kineticPoints, kineticBox, 0.01, 1, generator);
+    expectKineticMatches("moving 1 site in 200 by 20", kineticPoints, kineticBox, 20, 200, generator);
+    std::vector<cg3::Point2Dd> copiedPoints = kineticPoints;
+    copiedPoints.insert(copiedPoints.end(), kineticPoints.begin(), kineticPoints.begin() + 20);
+    expectKineticMatches("moving 20 copies of sites apart by 0.01", copiedPoints, kineticBox, 0.01, 1, generator);
+
+    std::printf("%d failed\n", failures);
+    return failures;
+}
@@ -13,9 +13,9 @@ namespace Voronoi {
 
     cg3::Pointd DrawableVoronoiDiagram::sceneCenter() const {
         cg3::Pointd center(0,0,0);
-        for(const Vertex& v : vertexs) {
-            center.x() += v.getCoordinates().x();
-            center.y() += v.getCoordinates().y();
+        for(size_t i = 0; i < vertexs.size(); i++) {
+            center.x() += getVertexCoordinates(i).x();
+            center.y() += getVertexCoordinates(i).y();
         }
         center /= vertexs.size();
         return center;
@@ -24,8 +24,8 @@ namespace Voronoi {
     double DrawableVoronoiDiagram::sceneRadius() const {
         double maxDist = 0, dist;
         cg3::Pointd center = sceneCenter();
-        for(const Vertex& v : vertexs) {
-            dist = v.getCoordinates().dist(cg3::Point2Dd(center.x(), center.y()));
+        for(size_t i = 0; i < vertexs.size(); i++) {
+            dist = getVertexCoordinates(i).dist(cg3::Point2Dd(center.x(), center.y()));
             maxDist = std::max(dist, maxDist);
         }
 
@@ -35,16 +35,16 @@ namespace Voronoi {
     void DrawableVoronoiDiagram::drawEdges() const {
         for(size_t i = 0; i < halfEdges.size(); i++) {
             if(halfEdges[i].getOriginID() != std::numeric_limits<size_t>::max() &&
-                    halfEdges[halfEdges[i].getTwinID()].getOriginID() != std::numeric_limits<size_t>::max())
-                cg3::viewer::drawLine2D(getHEOrigin(i).getCoordinates(), getHEOrigin(halfEdges[i].getTwinID()).getCoordinates(),
-                                    edgeColor, edgeWidth);
+                    halfEdges[getTwinID(i)].getOriginID() != std::numeric_limits<size_t>::max())
+                cg3::viewer::drawLine2D(getVertexCoordinates(halfEdges[i].getOriginID()),
+                                        getVertexCoordinates(halfEdges[getTwinID(i)].getOriginID()), edgeColor, edgeWidth);
         }
     }
 
     void DrawableVoronoiDiagram::drawPoints() const {
-        for(const Vertex& v : vertexs) {
-            if(v.getIncidEdgeID() != std::numeric_limits<size_t>::max())
-                cg3::viewer::drawPoint2D(v.getCoordinates(), pointColor, pointSize);
+        for(size_t i = 0; i < vertexs.size(); i++) {
+            if(vertexs[i].getIncidEdgeID() != std::numeric_limits<size_t>::max())
+                cg3::viewer::drawPoint2D(getVertexCoordinates(i), pointColor, pointSize);
         }
     }
 
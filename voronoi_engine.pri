@@ -0,0 +1,83 @@
+# Headless Voronoi engine: sweep, beachline, DCEL and mathVoronoi kernels.
+# It depends only on the header-only part of cg3 core (Point2D, BoundingBox2D)
+# and on the header-only arrays of cg3 data_structures (Array2D),
+# and can be included both by the GUI project and by VoronoiEngine.pro.
+
+INCLUDEPATH += $$PWD $$PWD/cg3lib/
+
+# CONFIG += voronoi_compact_dcel selects the compact DCEL (32-bit indices, implicit twins, plain vertexs).
+# It changes the layout of the DCEL, so the engine and its users must be built with the same setting
+voronoi_compact_dcel {
+    DEFINES += VORONOI_COMPACT_DCEL
+}
+
+# CONFIG += voronoi_float_coordinates stores the coordinates of the vertexs as floats (the diagram is still computed in double).
+# As the compact DCEL, it changes the layout of the DCEL for the engine and its users
+voronoi_float_coordinates {
+    DEFINES += VORONOI_FLOAT_COORDINATES
+}
+
+# CONFIG += voronoi_native compiles for the instruction set of the building machine,
+# so the SIMD loops of the raster diagram can use its vector gathers (e.g. AVX2)
+voronoi_native {
+    unix:!macx{
+        QMAKE_CXXFLAGS += -march=native
+    }
+}
+
+SOURCES += \
+    $$PWD/data_structures/vertex.tpp \
+    $$PWD/data_structures/half_edge.tpp \
+    $$PWD/data_structures/face.tpp \
+    $$PWD/data_structures/dcel.cpp \
+    $$PWD/data_structures/beachline.cpp \
+    $$PWD/data_structures/eventqueue.cpp \
+    $$PWD/data_structures/pool.tpp \
+    $$PWD/mathVoronoi/parabola.cpp \
+    $$PWD/mathVoronoi/circle.cpp \
+    $$PWD/mathVoronoi/predicates.cpp \
+    $$PWD/algorithms/radixsort.cpp \
+    $$PWD/algorithms/clipping.cpp \
+    $$PWD/algorithms/voronoidiagram.cpp \
+    $$PWD/algorithms/fortuneengine.cpp \
+    $$PWD/algorithms/duplicates.cpp \
+    $$PWD/algorithms/parallelfortune.cpp \
+    $$PWD/algorithms/batch.cpp \
+    $$PWD/algorithms/delaunay.cpp \
+    $$PWD/algorithms/halfplane.cpp \
+    $$PWD/algorithms/jumpflooding.cpp \
+    $$PWD/algorithms/voronoicells.cpp \
+    $$PWD/algorithms/cellrebuild.cpp \
+    $$PWD/algorithms/incremental.cpp \
+    $$PWD/algorithms/kinetic.cpp \
+    $$PWD/algorithms/slidingwindow.cpp
+
+HEADERS += \
+    $$PWD/data_structures/vertex.h \
+    $$PWD/data_structures/dcel_index.h \
+    $$PWD/data_structures/half_edge.h \
+    $$PWD/data_structures/face.h \
+    $$PWD/data_structures/dcel.h \
+    $$PWD/data_structures/sitespan.h \
+    $$PWD/data_structures/beachline.h \
+    $$PWD/data_structures/event.h \
+    $$PWD/data_structures/eventqueue.h \
+    $$PWD/data_structures/pool.h \
+    $$PWD/mathVoronoi/parabola.h \
+    $$PWD/mathVoronoi/circle.h \
+    $$PWD/mathVoronoi/predicates.h \
+    $$PWD/algorithms/radixsort.h \
+    $$PWD/algorithms/clipping.h \
+    $$PWD/algorithms/voronoidiagram.h \
+    $$PWD/algorithms/fortuneengine.h \
+    $$PWD/algorithms/duplicates.h \
+    $$PWD/algorithms/parallelfortune.h \
+    $$PWD/algorithms/batch.h \
+    $$PWD/algorithms/delaunay.h \
+    $$PWD/algorithms/halfplane.h \
+    $$PWD/algorithms/jumpflooding.h \
+    $$PWD/algorithms/voronoicells.h \
+    $$PWD/algorithms/cellrebuild.h \
+    $$PWD/algorithms/incremental.h \
+    $$PWD/algorithms/kinetic.h \
+    $$PWD/algorithms/slidingwindow.h